@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Nordic Semiconductor
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Flash and RAM use per module, read from the GNU ld map file.
+
+Application objects are reported one source file at a time (motor, servo,
+...); everything else is grouped by the library it was linked from. Only
+input sections that survived garbage collection appear in the map, and
+only those placed in allocated output sections are counted: debug info,
+.comment and the like never reach the device. Initialised data counts
+towards both flash (its load image) and RAM.
+
+With --elf the totals are checked against the image's loadable segments,
+the same figures readelf -l and size report. Alignment padding and linker
+fill belong to no module and are listed as (padding).
+
+Usage: app_size_report.py zephyr.map [--elf zephyr.elf] [--json out.json]
+                          [--compare old.json]
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+from collections import defaultdict
+from pathlib import Path
+
+MEMORY_RE = re.compile(r'^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)')
+OUTPUT_RE = re.compile(r'^(\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)'
+                       r'(?:\s+load address 0x([0-9a-fA-F]+))?$')
+INPUT_RE = re.compile(r'^ (\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S+)$')
+MEMBER_RE = re.compile(r'(?:^|[/\\])([^/\\(]+)\.a\(([^)]+)\)$')
+# Output sections without SHF_ALLOC, as placed by Zephyr's debug-sections.ld
+# and the toolchain. They sit at address 0 and their offsets run into the
+# flash range, so they have to be skipped by name.
+NON_ALLOC_RE = re.compile(r'^(?:\.debug|\.stab|\.comment$|\.line$|\.gnu\.build\.attributes$|'
+                          r'\.ARM\.attributes$|zephyr_dbg_info$)')
+PADDING = '(padding)'
+
+PT_LOAD = 1
+
+
+def parse_regions(lines):
+    """Return (name, start, end) for each region of the Memory Configuration."""
+    regions = []
+    in_table = False
+
+    for line in lines:
+        if line.startswith('Memory Configuration'):
+            in_table = True
+            continue
+        if in_table and line.startswith('Linker script and memory map'):
+            break
+        match = MEMORY_RE.match(line) if in_table else None
+        if match and match.group(1) != '*default*':
+            start = int(match.group(2), 16)
+            regions.append((match.group(1), start, start + int(match.group(3), 16)))
+
+    return regions
+
+
+def region_kind(regions, addr):
+    for name, start, end in regions:
+        if start <= addr < end:
+            upper = name.upper()
+            if 'FLASH' in upper or 'ROM' in upper:
+                return 'flash'
+            if 'RAM' in upper:
+                return 'ram'
+    return None
+
+
+def module_of(path):
+    """app/libapp.a(motor.c.obj) -> motor; zephyr/kernel/libkernel.a(...) -> libkernel."""
+    match = MEMBER_RE.search(path)
+    if not match:
+        return re.split(r'[/\\]', path)[-1]
+    lib, member = match.groups()
+    if lib == 'libapp':
+        return member.split('.')[0]
+    return lib
+
+
+def parse_map(path):
+    lines = Path(path).read_text(errors='replace').splitlines()
+    regions = parse_regions(lines)
+    sizes = defaultdict(lambda: {'flash': 0, 'ram': 0})
+    load_in_flash = False
+    allocated = True
+    pending_output = False
+    pending_name = None
+
+    start = next((i for i, l in enumerate(lines) if l.startswith('Linker script and memory map')),
+                 0)
+
+    for line in lines[start:]:
+        starts_output = bool(line) and not line[0].isspace()
+        if starts_output or pending_output:
+            if starts_output:
+                allocated = not NON_ALLOC_RE.match(line.split()[0])
+            # Long output section names put the addresses on the next line.
+            match = OUTPUT_RE.match(line)
+            if match:
+                lma = match.group(4)
+                load_in_flash = lma is not None and \
+                    region_kind(regions, int(lma, 16)) == 'flash'
+            pending_output = starts_output and not match
+            pending_name = None
+            if starts_output or match:
+                continue
+
+        match = INPUT_RE.match(line) if allocated else None
+        if not match:
+            # Long input section names are printed alone on their line.
+            stripped = line.strip()
+            pending_name = stripped if stripped.startswith('.') and ' ' not in stripped \
+                else None
+            continue
+
+        if match.group(1) is None and pending_name is None:
+            continue
+        if (match.group(1) or '').startswith('*'):
+            continue
+        pending_name = None
+
+        addr = int(match.group(2), 16)
+        size = int(match.group(3), 16)
+        kind = region_kind(regions, addr)
+        if size == 0 or kind is None:
+            continue
+
+        module = module_of(match.group(4))
+        sizes[module][kind] += size
+        if kind == 'ram' and load_in_flash:
+            sizes[module]['flash'] += size
+
+    return regions, dict(sizes)
+
+
+def elf_totals(path, regions):
+    """Flash and RAM taken by the PT_LOAD segments of an ELF image.
+
+    Flash is every byte loaded from the file, which is what ends up in
+    zephyr.bin; RAM is the in-memory size of segments that run from RAM.
+    """
+    data = Path(path).read_bytes()
+    if data[:4] != b'\x7fELF':
+        raise ValueError(f'{path}: not an ELF file')
+
+    is64 = data[4] == 2
+    endian = '<' if data[5] == 1 else '>'
+    if is64:
+        phoff, = struct.unpack_from(endian + 'Q', data, 0x20)
+        phentsize, phnum = struct.unpack_from(endian + 'HH', data, 0x36)
+        phdr = endian + 'IIQQQQQQ'
+    else:
+        phoff, = struct.unpack_from(endian + 'I', data, 0x1c)
+        phentsize, phnum = struct.unpack_from(endian + 'HH', data, 0x2a)
+        phdr = endian + 'IIIIIIII'
+
+    totals = {'flash': 0, 'ram': 0}
+    for i in range(phnum):
+        fields = struct.unpack_from(phdr, data, phoff + i * phentsize)
+        if is64:
+            p_type, _, _, vaddr, _, filesz, memsz, _ = fields
+        else:
+            p_type, _, vaddr, _, filesz, memsz, _, _ = fields
+        if p_type != PT_LOAD:
+            continue
+        totals['flash'] += filesz
+        if region_kind(regions, vaddr) == 'ram':
+            totals['ram'] += memsz
+
+    return totals
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('map', help='linker map file, e.g. build/zephyr/zephyr.map')
+    parser.add_argument('--elf', help='image linked with that map; checks the totals against it')
+    parser.add_argument('--json', help='write the per-module sizes to this file')
+    parser.add_argument('--compare', help='earlier --json output to print deltas against')
+    args = parser.parse_args()
+
+    regions, sizes = parse_map(args.map)
+
+    if args.elf:
+        image = elf_totals(args.elf, regions)
+        counted = {kind: sum(s[kind] for s in sizes.values()) for kind in ('flash', 'ram')}
+        if any(counted[kind] > image[kind] for kind in counted):
+            print(f'error: modules add up to {counted["flash"]} B flash, {counted["ram"]} B RAM '
+                  f'but {args.elf} only loads {image["flash"]} B, {image["ram"]} B',
+                  file=sys.stderr)
+            return 1
+        sizes[PADDING] = {kind: image[kind] - counted[kind] for kind in counted}
+
+    old = {}
+    if args.compare and Path(args.compare).exists():
+        old = json.loads(Path(args.compare).read_text())
+
+    def row(name, flash, ram, ref):
+        if ref is None:
+            return f'{name:<28} {flash:>8} {ram:>8}'
+        return (f'{name:<28} {flash:>8} {ram:>8} {flash - ref["flash"]:>+8} '
+                f'{ram - ref["ram"]:>+8}')
+
+    header = f'{"module":<28} {"flash":>8} {"ram":>8}'
+    if args.compare:
+        header += f' {"d_flash":>8} {"d_ram":>8}'
+    print(header)
+
+    # Application modules first, then libraries, each by flash size.
+    ordered = sorted(sizes.items(),
+                     key=lambda item: (item[0] == PADDING, item[0].startswith('lib'),
+                                       -item[1]['flash']))
+    for name, size in ordered:
+        ref = old.get(name, {'flash': 0, 'ram': 0}) if args.compare else None
+        print(row(name, size['flash'], size['ram'], ref))
+
+    total = {kind: sum(s[kind] for s in sizes.values()) for kind in ('flash', 'ram')}
+    ref = None
+    if args.compare:
+        ref = {kind: sum(s[kind] for s in old.values()) for kind in ('flash', 'ram')}
+    print(row('total', total['flash'], total['ram'], ref))
+
+    if args.json:
+        Path(args.json).write_text(json.dumps(sizes, indent=2, sort_keys=True) + '\n')
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
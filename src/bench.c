@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/sys/util.h>
+
+#if defined(CONFIG_ARCH_POSIX)
+#include <posix_board_if.h>
+#endif
+
+#include "bench.h"
+#include "bench_baseline.h"
+#include "bench_host.h"
+#include "input.h"
+#include "motor.h"
+#include "pwm_emul.h"
+#include "servo.h"
+#include "trace.h"
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+#define BUTTONS_NODE DT_PATH(buttons)
+#define SERVO_NODE   DT_NODELABEL(servo)
+
+#define BUTTON_SPEC(node_id) GPIO_DT_SPEC_GET(node_id, gpios),
+
+/* Time given to debounce windows and the motor thread after a script. */
+#define SETTLE_MS (CONFIG_APP_INPUT_DEBOUNCE_MS + 2 * DT_PWMS_PERIOD(SERVO_NODE) / NSEC_PER_MSEC)
+
+#if defined(CONFIG_APP_SERVO_PM)
+#define PARK_MS (CONFIG_APP_SERVO_HOLD_TIMEOUT_MS + 100)
+#endif
+
+/* motor_stats log costs are in host ns when the host clock is available. */
+/* Log call and resume times are host ns with CONFIG_APP_BENCH_HOST_CLOCK. */
+#if defined(CONFIG_APP_BENCH_HOST_CLOCK)
+#define COST_NS(c) ((uint64_t)(c))
+#else
+#define COST_NS(c) k_cyc_to_ns_floor64(c)
+#endif
+
+static const struct gpio_dt_spec buttons[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY(BUTTONS_NODE, BUTTON_SPEC)
+};
+
+static const struct device *const servo = DEVICE_DT_GET(SERVO_NODE);
+static const struct device *const pwm = DEVICE_DT_GET(DT_PWMS_CTLR(SERVO_NODE));
+
+/* Set a button to @p pressed, then let the simulation run for @p wait_ms. */
+struct bench_step {
+	uint8_t button;
+	uint8_t pressed;
+	uint16_t wait_ms;
+};
+
+struct bench_baseline {
+	uint32_t commands;
+	uint32_t reprograms;
+	uint32_t p99_us[TRACE_STAGE_COUNT];
+	uint32_t resume_us;
+};
+
+struct bench_scenario {
+	const char *name;
+	const struct bench_step *steps;
+	uint8_t step_count;
+	uint8_t repeat;
+	/* Idle time before the script starts, e.g. to let the servo park. */
+	uint16_t lead_ms;
+	struct bench_baseline baseline;
+};
+
+static const struct bench_step paced[] = {
+	{INPUT_BTN1, 1, 30}, {INPUT_BTN1, 0, 30},
+	{INPUT_BTN2, 1, 30}, {INPUT_BTN2, 0, 30},
+};
+
+static const struct bench_step burst[] = {
+	{INPUT_BTN1, 1, 6}, {INPUT_BTN1, 0, 6},
+	{INPUT_BTN2, 1, 6}, {INPUT_BTN2, 0, 6},
+};
+
+static const struct bench_step chatter[] = {
+	{INPUT_BTN1, 1, 1}, {INPUT_BTN1, 0, 1}, {INPUT_BTN1, 1, 1}, {INPUT_BTN1, 0, 1},
+	{INPUT_BTN1, 1, 100},
+	{INPUT_BTN1, 0, 1}, {INPUT_BTN1, 1, 1}, {INPUT_BTN1, 0, 100},
+};
+
+#if defined(CONFIG_APP_SERVO_PM)
+static const struct bench_step park[] = {
+	{INPUT_BTN2, 1, 50}, {INPUT_BTN2, 0, PARK_MS},
+};
+#endif
+
+static const struct bench_scenario scenarios[] = {
+	{"paced", paced, ARRAY_SIZE(paced), 10, 0, BENCH_BASELINE_PACED},
+	{"burst", burst, ARRAY_SIZE(burst), 16, 0, BENCH_BASELINE_BURST},
+	{"chatter", chatter, ARRAY_SIZE(chatter), 8, 0, BENCH_BASELINE_CHATTER},
+#if defined(CONFIG_APP_SERVO_PM)
+	{"park", park, ARRAY_SIZE(park), 2, PARK_MS, BENCH_BASELINE_PARK},
+#endif
+};
+
+/* Counters sampled before and after a script. */
+struct bench_snapshot {
+	struct input_stats input;
+	struct motor_stats motor;
+	struct pwm_emul_stats pwm;
+#if defined(CONFIG_APP_SERVO_PM)
+	struct servo_pm_stats pm;
+#endif
+};
+
+static void snapshot(struct bench_snapshot *snap)
+{
+	input_stats_get(&snap->input);
+	motor_stats_get(&snap->motor);
+	pwm_emul_stats_get(pwm, &snap->pwm);
+#if defined(CONFIG_APP_SERVO_PM)
+	servo_pm_stats_get(servo, &snap->pm);
+#endif
+}
+
+static void press(uint8_t button, bool pressed)
+{
+	const struct gpio_dt_spec *btn = &buttons[button];
+	bool active_low = (btn->dt_flags & GPIO_ACTIVE_LOW) != 0;
+
+	/* The emulator calls the input ISR synchronously from here. */
+	(void)gpio_emul_input_set(btn->port, btn->pin, pressed != active_low);
+}
+
+/* Latencies get one tick of slack on top of the tolerance, counts none. */
+static bool within(const char *name, const char *what, uint32_t measured, uint32_t baseline,
+		   uint32_t slack)
+{
+	uint32_t limit =
+		baseline + (uint64_t)baseline * CONFIG_APP_BENCH_TOLERANCE_PCT / 100 + slack;
+
+	if (measured > limit) {
+		LOG_ERR("%s: %s %u exceeds baseline %u (limit %u)", name, what, measured, baseline,
+			limit);
+		return false;
+	}
+
+	return true;
+}
+
+static bool run_scenario(const struct bench_scenario *sc)
+{
+	static const char *const stage_names[TRACE_STAGE_COUNT] = {
+		[TRACE_STAGE_HANDLER] = "handler p99",
+		[TRACE_STAGE_DEQUEUE] = "dequeue p99",
+		[TRACE_STAGE_PWM_DONE] = "pwm_done p99",
+	};
+	const struct bench_baseline *base = &sc->baseline;
+	struct bench_baseline got = {0};
+	struct bench_snapshot before;
+	struct bench_snapshot after;
+	struct trace_summary summary;
+	uint32_t dropped;
+	uint32_t logged;
+	int64_t start;
+	int64_t sim_ms;
+#if defined(CONFIG_APP_BENCH_HOST_CLOCK)
+	uint64_t host_start;
+	uint64_t host_us;
+	uint32_t events;
+#endif
+	bool ok = true;
+
+	k_msleep(sc->lead_ms);
+
+	snapshot(&before);
+	trace_reset();
+	start = k_uptime_get();
+#if defined(CONFIG_APP_BENCH_HOST_CLOCK)
+	host_start = bench_host_ns();
+#endif
+
+	for (uint8_t r = 0; r < sc->repeat; r++) {
+		for (uint8_t s = 0; s < sc->step_count; s++) {
+			press(sc->steps[s].button, sc->steps[s].pressed);
+			k_msleep(sc->steps[s].wait_ms);
+		}
+	}
+
+	k_msleep(SETTLE_MS);
+	sim_ms = k_uptime_get() - start;
+#if defined(CONFIG_APP_BENCH_HOST_CLOCK)
+	host_us = (bench_host_ns() - host_start) / NSEC_PER_USEC;
+#endif
+	snapshot(&after);
+
+	got.commands = after.motor.posted - before.motor.posted;
+	got.reprograms = after.pwm.reprograms - before.pwm.reprograms;
+	dropped = after.motor.dropped - before.motor.dropped;
+	logged = after.motor.applied - before.motor.applied;
+
+	for (int i = 0; i < TRACE_STAGE_COUNT; i++) {
+		if (trace_summary_get(i, &summary) == 0) {
+			got.p99_us[i] = k_cyc_to_us_ceil32(summary.p99_cyc);
+		}
+	}
+
+#if defined(CONFIG_APP_SERVO_PM)
+	got.resume_us = DIV_ROUND_UP(COST_NS(after.pm.resume_cyc_max), NSEC_PER_USEC);
+#endif
+
+	LOG_INF("%s: %u commands in %lld ms simulated, %u cmd/s, %u reprograms, %u dropped",
+		sc->name, got.commands, sim_ms, (uint32_t)(got.commands * 1000U / MAX(sim_ms, 1)),
+		got.reprograms, dropped);
+	LOG_INF("%s: p99 handler %u us, dequeue %u us, pwm_done %u us, resume %u us", sc->name,
+		got.p99_us[TRACE_STAGE_HANDLER], got.p99_us[TRACE_STAGE_DEQUEUE],
+		got.p99_us[TRACE_STAGE_PWM_DONE], got.resume_us);
+	LOG_INF("%s: %u log calls, %llu ns average", sc->name, logged,
+		COST_NS(after.motor.log_cyc_total - before.motor.log_cyc_total) / MAX(logged, 1));
+
+#if defined(CONFIG_APP_BENCH_HOST_CLOCK)
+	/*
+	 * Simulated time skips idle waits, so this measures how fast the host
+	 * pushes button events through ISR, queue, thread and PWM driver.
+	 */
+	events = after.input.events - before.input.events;
+	LOG_INF("%s: %u button events in %llu us host time, %llu events/s", sc->name, events,
+		host_us, (uint64_t)events * USEC_PER_SEC / MAX(host_us, 1));
+#endif
+
+	if (IS_ENABLED(CONFIG_APP_BENCH_RECORD)) {
+		LOG_INF("{ .commands = %u, .reprograms = %u, .p99_us = {%u, %u, %u}, "
+			".resume_us = %u }",
+			got.commands, got.reprograms, got.p99_us[0], got.p99_us[1], got.p99_us[2],
+			got.resume_us);
+	}
+
+	if (got.commands != base->commands) {
+		LOG_ERR("%s: %u commands, expected %u", sc->name, got.commands, base->commands);
+		ok = false;
+	}
+
+	if (dropped != 0) {
+		LOG_ERR("%s: %u commands dropped", sc->name, dropped);
+		ok = false;
+	}
+
+	if (after.pwm.suspended_writes != before.pwm.suspended_writes) {
+		LOG_ERR("%s: PWM written while suspended", sc->name);
+		ok = false;
+	}
+
+	ok &= within(sc->name, "reprograms", got.reprograms, base->reprograms, 0);
+
+	for (int i = 0; i < TRACE_STAGE_COUNT; i++) {
+		ok &= within(sc->name, stage_names[i], got.p99_us[i], base->p99_us[i],
+			     k_ticks_to_us_ceil32(1));
+	}
+
+#if defined(CONFIG_APP_SERVO_PM)
+	uint32_t resumes = after.pm.resumes - before.pm.resumes;
+	uint32_t suspends = after.pm.suspends - before.pm.suspends;
+
+	LOG_INF("%s: %u resumes, %u suspends, %llu ms active, %llu ms parked", sc->name, resumes,
+		suspends, after.pm.active_ms - before.pm.active_ms,
+		after.pm.suspended_ms - before.pm.suspended_ms);
+
+	ok &= within(sc->name, "resume", got.resume_us, base->resume_us, k_ticks_to_us_ceil32(1));
+
+	/* Scripts end idle for longer than the hold timeout or not at all. */
+	if (resumes != suspends) {
+		LOG_ERR("%s: %u resumes but %u suspends", sc->name, resumes, suspends);
+		ok = false;
+	}
+#endif
+
+	return ok;
+}
+
+int bench_run(void)
+{
+	struct motor_stats motor;
+	bool ok = true;
+
+	if (!device_is_ready(pwm)) {
+		return -ENODEV;
+	}
+
+	LOG_INF("Running %zu scenarios, tolerance %d%%", ARRAY_SIZE(scenarios),
+		CONFIG_APP_BENCH_TOLERANCE_PCT);
+
+	for (size_t i = 0; i < ARRAY_SIZE(scenarios); i++) {
+		ok &= run_scenario(&scenarios[i]);
+	}
+
+	motor_stats_get(&motor);
+	LOG_INF("Slowest log call %llu ns", COST_NS(motor.log_cyc_max));
+	LOG_INF("Benchmark %s", ok ? "PASS" : "FAIL");
+
+#if defined(CONFIG_ARCH_POSIX)
+	/* Flush deferred messages before the process goes away. */
+	LOG_PANIC();
+	posix_exit(ok ? 0 : 1);
+#endif
+
+	return ok ? 0 : -EFAULT;
+}
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/**
+ * Replay the scripted button sequences through the emulated GPIO controller,
+ * report each scenario and compare it with the stored baseline
+ * (bench_baseline.h). Ends with "Benchmark PASS" or "Benchmark FAIL".
+ *
+ * Must be called after motor_init() and input_init().
+ *
+ * @retval 0 Every scenario is within its baseline.
+ * @retval -EFAULT At least one scenario regressed.
+ */
+int bench_run(void);
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BENCH_BASELINE_H_
+#define BENCH_BASELINE_H_
+
+/*
+ * Stored benchmark baselines, one per scenario in bench.c. A run fails when
+ * the command count differs, or when a reprogram count or latency exceeds
+ * its baseline by more than CONFIG_APP_BENCH_TOLERANCE_PCT; latencies get
+ * one tick on top.
+ *
+ * Build with CONFIG_APP_BENCH_RECORD=y to print the measured values in this
+ * format, and paste them here when a change is meant to move the numbers.
+ *
+ * Latencies are p99 in microseconds for the handler, dequeue and pwm_done
+ * stages; resume is the worst servo wake-up, also in microseconds. On
+ * native_sim resume is host time, since simulated time does not move during
+ * the wake-up: its baseline of 0 allows one tick, 1 ms, of host time.
+ */
+
+/*
+ * Alternating presses held 30 ms, 30 ms apart: every command applied at once.
+ * Simulated time stands still between the edge and the PWM update, so every
+ * stage reads zero.
+ */
+#define BENCH_BASELINE_PACED                                                                       \
+	{ .commands = 20, .reprograms = 20, .p99_us = {0, 0, 0}, .resume_us = 0 }
+
+/*
+ * 6 ms pulses alternating every 6 ms, so each button is pressed every 24 ms.
+ * The release falls inside the 20 ms debounce window and is reported when it
+ * closes, 14 ms after the edge. That report opens a new window, which
+ * swallows the button's next press: only every other press posts a command,
+ * one every 24 ms, each applied within the PWM period it arrives in.
+ */
+#define BENCH_BASELINE_BURST                                                                       \
+	{ .commands = 16, .reprograms = 16, .p99_us = {14000, 7000, 7000}, .resume_us = 0 }
+
+/* Presses and releases with 1 ms contact bounce: one command per press. */
+#define BENCH_BASELINE_CHATTER                                                                     \
+	{ .commands = 8, .reprograms = 8, .p99_us = {0, 0, 0}, .resume_us = 0 }
+
+/* Presses after the hold timeout: each resumes the servo and parks it again. */
+#define BENCH_BASELINE_PARK                                                                        \
+	{ .commands = 2, .reprograms = 4, .p99_us = {0, 0, 0}, .resume_us = 0 }
+
+#endif /* BENCH_BASELINE_H_ */
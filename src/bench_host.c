@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Built into the native_sim runner rather than the Zephyr image, so it can
+ * use the host C library directly.
+ */
+
+#include <stdint.h>
+#include <time.h>
+
+#include "bench_host.h"
+
+uint64_t bench_host_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BENCH_HOST_H_
+#define BENCH_HOST_H_
+
+#include <stdint.h>
+
+/**
+ * Host monotonic time in nanoseconds. Only available with
+ * CONFIG_APP_BENCH_HOST_CLOCK; implemented in the native_sim runner.
+ */
+uint64_t bench_host_ns(void);
+
+#endif /* BENCH_HOST_H_ */
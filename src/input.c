@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/sys/util.h>
+
+#include "input.h"
+
+LOG_MODULE_REGISTER(input, LOG_LEVEL_INF);
+
+#define BUTTONS_NODE DT_PATH(buttons)
+
+#define BUTTON_SPEC(node_id) GPIO_DT_SPEC_GET(node_id, gpios),
+
+static const struct gpio_dt_spec buttons[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY(BUTTONS_NODE, BUTTON_SPEC)
+};
+
+/*
+ * Debounce is leading-edge: the first edge seen on a stable button is
+ * reported immediately and opens a settle window. Edges inside the window
+ * are treated as bounce. When the window closes the pin is sampled once
+ * more and a late transition is reported if the level moved, so the
+ * reported state always converges on the real one. The settle timer only
+ * runs after an edge, which keeps the CPU asleep while nobody presses.
+ */
+struct button_data {
+	struct gpio_callback cb;
+	struct k_timer settle;
+	uint32_t last_edge_cyc;
+	uint8_t idx;
+	bool reported;
+	bool settling;
+};
+
+static struct button_data button_data[ARRAY_SIZE(buttons)];
+static input_handler_t input_handler;
+
+/*
+ * Serialises the GPIO ISR and the settle timer, which may run at different
+ * interrupt priorities, so the handler sees a single producer.
+ */
+static struct k_spinlock button_lock;
+static struct input_stats activity;
+
+static void report(struct button_data *data, bool pressed, uint32_t edge_cyc)
+{
+	struct input_event evt = {
+		.button = data->idx,
+		.pressed = pressed,
+		.edge_cyc = edge_cyc,
+	};
+
+	data->reported = pressed;
+	data->settling = true;
+	activity.events++;
+	k_timer_start(&data->settle, K_MSEC(CONFIG_APP_INPUT_DEBOUNCE_MS), K_NO_WAIT);
+
+	input_handler(&evt);
+}
+
+static void settle_expired(struct k_timer *timer)
+{
+	struct button_data *data = CONTAINER_OF(timer, struct button_data, settle);
+	k_spinlock_key_t key = k_spin_lock(&button_lock);
+	int level = gpio_pin_get_dt(&buttons[data->idx]);
+
+	data->settling = false;
+	activity.settles++;
+
+	if (level >= 0 && (bool)level != data->reported) {
+		report(data, level, data->last_edge_cyc);
+	}
+
+	k_spin_unlock(&button_lock, key);
+}
+
+static void button_isr(const struct device *port, struct gpio_callback *cb, uint32_t pins)
+{
+	struct button_data *data = CONTAINER_OF(cb, struct button_data, cb);
+	uint32_t now = k_cycle_get_32();
+	k_spinlock_key_t key;
+	int level;
+
+	ARG_UNUSED(port);
+	ARG_UNUSED(pins);
+
+	key = k_spin_lock(&button_lock);
+
+	data->last_edge_cyc = now;
+	activity.edges++;
+
+	if (!data->settling) {
+		level = gpio_pin_get_dt(&buttons[data->idx]);
+		if (level >= 0 && (bool)level != data->reported) {
+			report(data, level, now);
+		}
+	}
+
+	k_spin_unlock(&button_lock, key);
+}
+
+int input_init(input_handler_t handler)
+{
+	int err;
+
+	if (handler == NULL) {
+		return -EINVAL;
+	}
+
+	input_handler = handler;
+
+	for (size_t i = 0; i < ARRAY_SIZE(buttons); i++) {
+		const struct gpio_dt_spec *btn = &buttons[i];
+		struct button_data *data = &button_data[i];
+
+		if (!gpio_is_ready_dt(btn)) {
+			LOG_ERR("Button %zu GPIO %s is not ready", i, btn->port->name);
+			return -ENODEV;
+		}
+
+		err = gpio_pin_configure_dt(btn, GPIO_INPUT);
+		if (err) {
+			LOG_ERR("Cannot configure button %zu, err %d", i, err);
+			return err;
+		}
+
+		data->idx = i;
+		data->reported = gpio_pin_get_dt(btn) > 0;
+		k_timer_init(&data->settle, settle_expired, NULL);
+
+		gpio_init_callback(&data->cb, button_isr, BIT(btn->pin));
+		err = gpio_add_callback_dt(btn, &data->cb);
+		if (err) {
+			LOG_ERR("Cannot add callback for button %zu, err %d", i, err);
+			return err;
+		}
+
+		err = gpio_pin_interrupt_configure_dt(btn, GPIO_INT_EDGE_BOTH);
+		if (err) {
+			LOG_ERR("Cannot enable interrupt for button %zu, err %d", i, err);
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+void input_stats_get(struct input_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&button_lock);
+
+	*stats = activity;
+
+	k_spin_unlock(&button_lock, key);
+}
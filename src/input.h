@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef INPUT_H_
+#define INPUT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Index of each child of the /buttons node, in devicetree order. */
+#define INPUT_BTN1 0
+#define INPUT_BTN2 1
+#define INPUT_BTN3 2
+#define INPUT_BTN4 3
+
+/** Debounced button transition. */
+struct input_event {
+	/** Button index, see INPUT_BTN1 and friends. */
+	uint8_t button;
+	/** True on press, false on release. */
+	bool pressed;
+	/** k_cycle_get_32() captured in the GPIO ISR for the first edge. */
+	uint32_t edge_cyc;
+};
+
+/**
+ * Called once per debounced transition, from interrupt context
+ * (GPIO ISR for the leading edge, k_timer expiry for a late release).
+ * Invocations never overlap, so the handler may act as a single producer.
+ */
+typedef void (*input_handler_t)(const struct input_event *evt);
+
+/** Input activity counters, for checking that idle buttons cost nothing. */
+struct input_stats {
+	/** GPIO edge interrupts taken. */
+	uint32_t edges;
+	/** Settle timer expiries. */
+	uint32_t settles;
+	/** Events delivered to the handler. */
+	uint32_t events;
+};
+
+/**
+ * Configure every /buttons child for edge interrupts and start delivering
+ * events to @p handler. No work is scheduled while the buttons are idle.
+ */
+int input_init(input_handler_t handler);
+
+/** Copy out the activity counters. */
+void input_stats_get(struct input_stats *stats);
+
+#endif /* INPUT_H_ */
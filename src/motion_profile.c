@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "motion_profile.h"
+
+#define DIV_CEIL(n, d) (((n) + (d) - 1) / (d))
+
+static uint32_t isqrt_ceil(uint64_t n)
+{
+	uint64_t root = 0;
+	uint64_t bit = 1ULL << 62;
+
+	while (bit > n) {
+		bit >>= 2;
+	}
+
+	while (bit != 0) {
+		if (n >= root + bit) {
+			n -= root + bit;
+			root = (root >> 1) + bit;
+		} else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return (uint32_t)(n != 0 ? root + 1 : root);
+}
+
+void motion_limits_from_rate(struct motion_limits *limits, uint32_t speed_dps,
+			     uint32_t accel_dps2, uint32_t period_us)
+{
+	uint64_t vel = ((uint64_t)speed_dps << 16) * period_us / 1000000U;
+	uint64_t acc = ((uint64_t)accel_dps2 << 16) * period_us / 1000000U * period_us / 1000000U;
+
+	limits->vel_q16 = vel > 0 ? (uint32_t)vel : 1;
+	limits->acc_q16 = acc > 0 ? (uint32_t)acc : 1;
+}
+
+static void plan_trapezoid(struct motion_profile *profile, uint64_t dist,
+			   const struct motion_limits *limits)
+{
+	uint32_t ramp = DIV_CEIL(limits->vel_q16, limits->acc_q16);
+
+	if ((uint64_t)limits->vel_q16 * ramp >= dist) {
+		/* Never reaches full speed: accelerate, then brake. */
+		ramp = isqrt_ceil(DIV_CEIL(dist, limits->acc_q16));
+		profile->steps = 2 * ramp;
+	} else {
+		profile->steps = ramp + (uint32_t)DIV_CEIL(dist, limits->vel_q16);
+	}
+
+	profile->ramp = ramp;
+}
+
+static void plan_scurve(struct motion_profile *profile, uint64_t dist,
+			const struct motion_limits *limits)
+{
+	/*
+	 * The quintic peaks at 15/8 * D/N velocity and 10/sqrt(3) * D/N^2
+	 * acceleration; pick the shortest N that honours both.
+	 */
+	uint64_t by_vel = DIV_CEIL(15 * dist, 8 * (uint64_t)limits->vel_q16);
+	uint64_t by_acc = isqrt_ceil(DIV_CEIL(dist * 57735U, 10000U * (uint64_t)limits->acc_q16));
+
+	profile->steps = (uint32_t)(by_vel > by_acc ? by_vel : by_acc);
+	profile->ramp = 0;
+}
+
+void motion_profile_plan(struct motion_profile *profile, enum motion_shape shape,
+			 int32_t distance_q8, const struct motion_limits *limits)
+{
+	uint64_t dist = (uint64_t)(distance_q8 < 0 ? -(int64_t)distance_q8 : distance_q8) << 8;
+
+	profile->shape = shape;
+	profile->steps = 1;
+	profile->ramp = 0;
+
+	if (dist == 0) {
+		return;
+	}
+
+	if (shape == MOTION_SCURVE) {
+		plan_scurve(profile, dist, limits);
+	} else {
+		plan_trapezoid(profile, dist, limits);
+	}
+
+	if (profile->steps == 0) {
+		profile->steps = 1;
+	}
+}
+
+static uint32_t progress_trapezoid(const struct motion_profile *profile, uint32_t k)
+{
+	uint64_t n = profile->steps;
+	uint64_t r = profile->ramp;
+	/* Peak velocity is 1 / (N - R); every branch shares that denominator. */
+	uint64_t den = 2 * (n - r);
+
+	if (r == 0) {
+		return (uint32_t)(((uint64_t)k << 16) / n);
+	}
+
+	if (k <= r) {
+		return (uint32_t)(((uint64_t)k * k << 16) / (den * r));
+	}
+
+	if (k <= n - r) {
+		return (uint32_t)(((2 * (uint64_t)k - r) << 16) / den);
+	}
+
+	/* Round the remainder up so every branch floors the exact progress. */
+	return MOTION_PROGRESS_ONE - (uint32_t)DIV_CEIL((n - k) * (n - k) << 16, den * r);
+}
+
+static uint32_t progress_scurve(const struct motion_profile *profile, uint32_t k)
+{
+	/*
+	 * s(t) = 10 t^3 - 15 t^4 + 6 t^5 = t^3 (10 - 15 t + 6 t^2), t in Q30.
+	 * A Q16 t would advance in uneven one- or two-LSB steps on moves of
+	 * more than a few thousand steps, which shows up as speed ripple and
+	 * even backward steps. t^3 < 2^30 and 1 <= inner <= 10 * 2^30, so
+	 * their product fits 64 bits unsigned.
+	 */
+	uint64_t t = ((uint64_t)k << 30) / profile->steps;
+	uint64_t t2 = (t * t) >> 30;
+	uint64_t t3 = (t2 * t) >> 30;
+	uint64_t inner = (10ULL << 30) - 15 * t + 6 * t2;
+
+	return (uint32_t)((t3 * inner) >> 44);
+}
+
+uint32_t motion_profile_progress(const struct motion_profile *profile, uint32_t k)
+{
+	if (k >= profile->steps) {
+		return MOTION_PROGRESS_ONE;
+	}
+
+	if (profile->shape == MOTION_SCURVE) {
+		return progress_scurve(profile, k);
+	}
+
+	return progress_trapezoid(profile, k);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef MOTION_PROFILE_H_
+#define MOTION_PROFILE_H_
+
+/*
+ * Point-to-point motion profiles in integer arithmetic. Kept free of kernel
+ * dependencies so it can be compiled and exercised on the host.
+ *
+ * A profile is planned once from a distance and the speed/acceleration
+ * limits and then sampled once per PWM period ("step"). Samples are the
+ * normalised progress along the move in Q16 (0 at the start, 65536 at the
+ * end), so one plan can drive several servos with different travel that
+ * start and stop together.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MOTION_PROGRESS_ONE (1U << 16)
+
+enum motion_shape {
+	/** Constant acceleration, cruise, constant deceleration. */
+	MOTION_TRAPEZOID,
+	/** Minimum-jerk quintic; smooth acceleration at both ends. */
+	MOTION_SCURVE,
+};
+
+/** Limits per step. Q16 degrees per step and per step squared. */
+struct motion_limits {
+	uint32_t vel_q16;
+	uint32_t acc_q16;
+};
+
+struct motion_profile {
+	enum motion_shape shape;
+	/** Total number of steps; the last sample (index steps) is the target. */
+	uint32_t steps;
+	/** Trapezoid ramp length in steps. */
+	uint32_t ramp;
+};
+
+/**
+ * Convert limits given in degrees per second (squared) for a step period of
+ * @p period_us microseconds.
+ */
+void motion_limits_from_rate(struct motion_limits *limits, uint32_t speed_dps,
+			     uint32_t accel_dps2, uint32_t period_us);
+
+/**
+ * Plan a move over @p distance_q8 (Q8 degrees, sign ignored).
+ *
+ * A zero distance yields a single-step profile that lands on the target.
+ */
+void motion_profile_plan(struct motion_profile *profile, enum motion_shape shape,
+			 int32_t distance_q8, const struct motion_limits *limits);
+
+/** Progress at step @p k in Q16, clamped to MOTION_PROGRESS_ONE past the end. */
+uint32_t motion_profile_progress(const struct motion_profile *profile, uint32_t k);
+
+/** Interpolate between @p from_q8 and @p to_q8 at Q16 progress @p progress. */
+static inline int32_t motion_profile_lerp(int32_t from_q8, int32_t to_q8, uint32_t progress)
+{
+	return from_q8 + (int32_t)(((int64_t)(to_q8 - from_q8) * progress) >> 16);
+}
+
+#endif /* MOTION_PROFILE_H_ */
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+
+#include "bench_host.h"
+#include "motor.h"
+#include "servo.h"
+#include "servo_group.h"
+#include "trace.h"
+
+LOG_MODULE_REGISTER(motor, LOG_LEVEL_INF);
+
+#define SERVO_NODE DT_NODELABEL(servo)
+#define PWM_PERIOD DT_PWMS_PERIOD(SERVO_NODE)
+
+#define BUTTON_ONE(node_id) +1
+#define BUTTON_COUNT        (0 DT_FOREACH_CHILD_STATUS_OKAY(DT_PATH(buttons), BUTTON_ONE))
+
+/*
+ * Each button posts at most once per debounce window and the thread drains
+ * the ring at least once per PWM period, so this bounds the backlog.
+ */
+#define POSTS_PER_PERIOD                                                                           \
+	(DIV_ROUND_UP(PWM_PERIOD, MAX(CONFIG_APP_INPUT_DEBOUNCE_MS, 1) * NSEC_PER_MSEC) + 1)
+
+#define POW2_CEIL(n)                                                                               \
+	((n) <= 2 ? 2 : (n) <= 4 ? 4 : (n) <= 8 ? 8 : (n) <= 16 ? 16 : (n) <= 32 ? 32 : 64)
+
+#if CONFIG_APP_MOTOR_QUEUE_SIZE > 0
+#define QUEUE_SIZE CONFIG_APP_MOTOR_QUEUE_SIZE
+#else
+#define QUEUE_SIZE POW2_CEIL(BUTTON_COUNT * POSTS_PER_PERIOD)
+BUILD_ASSERT(QUEUE_SIZE >= BUTTON_COUNT * POSTS_PER_PERIOD,
+	     "Too many buttons to size the motor queue, set CONFIG_APP_MOTOR_QUEUE_SIZE");
+#endif
+#define QUEUE_MASK (QUEUE_SIZE - 1)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(QUEUE_SIZE), "Motor queue size must be a power of two");
+
+static const struct device *const servo = DEVICE_DT_GET(SERVO_NODE);
+
+#if defined(CONFIG_APP_SERVO_GROUP)
+static const struct device *const servo_group = DEVICE_DT_GET(DT_NODELABEL(servo_group));
+#endif
+
+struct motor_cmd {
+	int32_t deg;
+	uint32_t edge_cyc;
+	uint8_t target;
+};
+
+/*
+ * Single-producer/single-consumer ring. The producer only writes head and
+ * the consumer only writes tail; both indices run freely and are masked on
+ * access, so a full ring is head - tail == QUEUE_SIZE.
+ */
+static struct motor_cmd queue[QUEUE_SIZE];
+static atomic_t head;
+static atomic_t tail;
+
+static atomic_t posted;
+static atomic_t dropped;
+static atomic_t coalesced;
+static atomic_t applied;
+static atomic_t depth_max;
+
+/* Only written by the motor thread. */
+static uint64_t log_cyc_total;
+static uint32_t log_cyc_max;
+
+static K_SEM_DEFINE(wake, 0, 1);
+
+#if defined(CONFIG_APP_BENCH_HOST_CLOCK)
+/* Simulated time stands still while the log call runs; use host ns instead. */
+#define LOG_CLOCK() ((uint32_t)bench_host_ns())
+#else
+#define LOG_CLOCK() k_cycle_get_32()
+#endif
+
+int motor_post(enum motor_target target, int32_t deg, uint32_t edge_cyc)
+{
+	atomic_val_t h = atomic_get(&head);
+
+	if (target >= MOTOR_TARGET_COUNT ||
+	    (target == MOTOR_GROUP && !IS_ENABLED(CONFIG_APP_SERVO_GROUP))) {
+		return -ENOTSUP;
+	}
+
+	if ((atomic_val_t)(h - atomic_get(&tail)) >= QUEUE_SIZE) {
+		atomic_inc(&dropped);
+		return -ENOBUFS;
+	}
+
+	queue[h & QUEUE_MASK] = (struct motor_cmd){
+		.deg = deg,
+		.edge_cyc = edge_cyc,
+		.target = target,
+	};
+	atomic_set(&head, h + 1);
+	atomic_inc(&posted);
+
+	k_sem_give(&wake);
+
+	return 0;
+}
+
+/*
+ * Take everything queued so far and keep only the newest command for each
+ * target. Returns the number of targets with a pending command.
+ */
+static int drain(struct motor_cmd newest[MOTOR_TARGET_COUNT], bool pending[MOTOR_TARGET_COUNT])
+{
+	atomic_val_t t = atomic_get(&tail);
+	atomic_val_t h = atomic_get(&head);
+	atomic_val_t depth = h - t;
+	int targets = 0;
+
+	if (depth == 0) {
+		return 0;
+	}
+
+	if (depth > atomic_get(&depth_max)) {
+		atomic_set(&depth_max, depth);
+	}
+
+	for (; t != h; t++) {
+		const struct motor_cmd *cmd = &queue[t & QUEUE_MASK];
+
+		if (!pending[cmd->target]) {
+			pending[cmd->target] = true;
+			targets++;
+		}
+		newest[cmd->target] = *cmd;
+	}
+
+	atomic_set(&tail, h);
+	atomic_add(&coalesced, depth - targets);
+
+	return targets;
+}
+
+static int apply(const struct motor_cmd *cmd)
+{
+	switch (cmd->target) {
+	case MOTOR_SERVO:
+#if defined(CONFIG_APP_SERVO_MOTION)
+		return servo_move(servo, cmd->deg);
+#else
+		return servo_set_angle(servo, cmd->deg);
+#endif
+#if defined(CONFIG_APP_SERVO_GROUP) && defined(CONFIG_APP_SERVO_MOTION)
+	case MOTOR_GROUP:
+		return servo_group_move_all(servo_group, cmd->deg);
+#elif defined(CONFIG_APP_SERVO_GROUP)
+	case MOTOR_GROUP:
+		return servo_group_set_all(servo_group, cmd->deg);
+#endif
+	default:
+		return -ENOTSUP;
+	}
+}
+
+FUNC_NORETURN void motor_run(void)
+{
+	struct motor_cmd cmd[MOTOR_TARGET_COUNT];
+	int64_t next_slot = 0;
+	uint32_t log_start;
+	uint32_t log_cyc;
+	int err;
+
+	if (IS_ENABLED(CONFIG_APP_MOTOR_MAIN_THREAD)) {
+		k_thread_priority_set(k_current_get(), CONFIG_APP_MOTOR_THREAD_PRIORITY);
+	}
+
+	while (true) {
+		bool pending[MOTOR_TARGET_COUNT] = {0};
+
+		k_sem_take(&wake, K_FOREVER);
+
+		/*
+		 * Apply at most one command per target and PWM period.
+		 * Anything posted while waiting for the next slot is folded
+		 * into the drain.
+		 */
+		k_sleep(K_TIMEOUT_ABS_TICKS(next_slot));
+
+		if (drain(cmd, pending) == 0) {
+			continue;
+		}
+
+		next_slot = k_uptime_ticks() + k_ns_to_ticks_ceil64(PWM_PERIOD);
+
+		for (int i = 0; i < MOTOR_TARGET_COUNT; i++) {
+			if (!pending[i]) {
+				continue;
+			}
+
+			TRACE_POINT(TRACE_STAGE_DEQUEUE, cmd[i].edge_cyc);
+
+			err = apply(&cmd[i]);
+			if (err) {
+				LOG_ERR("Target %d: set angle returned %d", i, err);
+				continue;
+			}
+
+			TRACE_POINT(TRACE_STAGE_PWM_DONE, cmd[i].edge_cyc);
+
+			atomic_inc(&applied);
+
+			/*
+			 * Integer arguments only, so deferred mode packs the
+			 * message without copying strings. The cost is tracked
+			 * to compare logging modes.
+			 */
+			log_start = LOG_CLOCK();
+			LOG_INF("Target %d set to %d degrees", i, cmd[i].deg);
+			log_cyc = LOG_CLOCK() - log_start;
+
+			log_cyc_total += log_cyc;
+			log_cyc_max = MAX(log_cyc_max, log_cyc);
+		}
+	}
+}
+
+#if !defined(CONFIG_APP_MOTOR_MAIN_THREAD)
+static void motor_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	motor_run();
+}
+
+K_THREAD_DEFINE(motor_tid, CONFIG_APP_MOTOR_THREAD_STACK_SIZE, motor_thread, NULL, NULL, NULL,
+		CONFIG_APP_MOTOR_THREAD_PRIORITY, 0, K_TICKS_FOREVER);
+#endif
+
+int motor_init(int32_t initial_deg)
+{
+	int err;
+
+	if (!device_is_ready(servo)) {
+		LOG_ERR("Error: servo device %s is not ready", servo->name);
+		return -ENODEV;
+	}
+
+#if defined(CONFIG_APP_SERVO_GROUP)
+	if (!device_is_ready(servo_group)) {
+		LOG_ERR("Error: servo group %s is not ready", servo_group->name);
+		return -ENODEV;
+	}
+
+	err = servo_group_set_all(servo_group, initial_deg);
+	if (err) {
+		LOG_ERR("servo_group_set_all returned %d", err);
+		return err;
+	}
+#endif
+
+	err = servo_set_angle(servo, initial_deg);
+	if (err) {
+		LOG_ERR("servo_set_angle returned %d", err);
+		return err;
+	}
+
+#if !defined(CONFIG_APP_MOTOR_MAIN_THREAD)
+	k_thread_start(motor_tid);
+#endif
+
+	return 0;
+}
+
+void motor_stats_get(struct motor_stats *stats)
+{
+	stats->posted = atomic_get(&posted);
+	stats->dropped = atomic_get(&dropped);
+	stats->coalesced = atomic_get(&coalesced);
+	stats->applied = atomic_get(&applied);
+	stats->depth_max = atomic_get(&depth_max);
+	stats->log_cyc_total = log_cyc_total;
+	stats->log_cyc_max = log_cyc_max;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef MOTOR_H_
+#define MOTOR_H_
+
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+/** What a motor command moves. */
+enum motor_target {
+	/** The single pwm-servo instance labelled "servo". */
+	MOTOR_SERVO,
+	/** Every servo of the pwm-servo-group labelled "servo_group". */
+	MOTOR_GROUP,
+	MOTOR_TARGET_COUNT,
+};
+
+/** Motor command queue counters. */
+struct motor_stats {
+	/** Commands accepted into the queue. */
+	uint32_t posted;
+	/** Commands rejected because the queue was full. */
+	uint32_t dropped;
+	/** Commands superseded by a newer one for the same target. */
+	uint32_t coalesced;
+	/** Commands written to the PWM peripheral. */
+	uint32_t applied;
+	/** Highest queue depth seen by the motor thread. */
+	uint32_t depth_max;
+	/**
+	 * Cycles spent in the per-command log call, total and worst case.
+	 * Host nanoseconds with CONFIG_APP_BENCH_HOST_CLOCK.
+	 */
+	uint64_t log_cyc_total;
+	uint32_t log_cyc_max;
+};
+
+/**
+ * Check the servo devices, drive them to the initial angle and start the
+ * motor control thread. Must be called before motor_post().
+ *
+ * With CONFIG_APP_MOTOR_MAIN_THREAD no thread is started; the caller must
+ * hand its own thread over with motor_run() instead.
+ */
+int motor_init(int32_t initial_deg);
+
+/**
+ * Motor control loop. Runs on its own thread, or with
+ * CONFIG_APP_MOTOR_MAIN_THREAD on the calling thread, which it moves to
+ * CONFIG_APP_MOTOR_THREAD_PRIORITY. Never returns.
+ */
+FUNC_NORETURN void motor_run(void);
+
+/**
+ * Queue a new angle for one target of the motor thread.
+ *
+ * Lock-free and allocation-free; callable from ISRs. The queue has a single
+ * producer: callers must not invoke this concurrently from two contexts.
+ *
+ * @param target   What to move.
+ * @param deg      Target angle in degrees.
+ * @param edge_cyc Cycle stamp of the input that caused the command, used for
+ *                 press-to-PWM latency accounting.
+ *
+ * @retval 0 Command queued.
+ * @retval -ENOBUFS Queue full, command dropped.
+ * @retval -ENOTSUP Target not available in this build.
+ */
+int motor_post(enum motor_target target, int32_t deg, uint32_t edge_cyc);
+
+/** Copy out the queue counters. */
+void motor_stats_get(struct motor_stats *stats);
+
+#endif /* MOTOR_H_ */
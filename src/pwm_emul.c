@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define DT_DRV_COMPAT pwm_emul
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/pwm.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/sys/util.h>
+
+#include "pwm_emul.h"
+
+struct pwm_emul_channel {
+	uint32_t period;
+	uint32_t pulse;
+};
+
+struct pwm_emul_config {
+	uint8_t count;
+};
+
+struct pwm_emul_data {
+	struct k_spinlock lock;
+	bool suspended;
+	struct pwm_emul_stats stats;
+	struct pwm_emul_channel *channels;
+};
+
+static int pwm_emul_set_cycles(const struct device *dev, uint32_t channel, uint32_t period_cycles,
+			       uint32_t pulse_cycles, pwm_flags_t flags)
+{
+	const struct pwm_emul_config *config = dev->config;
+	struct pwm_emul_data *data = dev->data;
+	k_spinlock_key_t key;
+	int err = 0;
+
+	ARG_UNUSED(flags);
+
+	if (channel >= config->count || pulse_cycles > period_cycles) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&data->lock);
+
+	/* Real hardware would drop the write, or worse, glitch the output. */
+	if (data->suspended) {
+		data->stats.suspended_writes++;
+		err = -EIO;
+	} else {
+		data->channels[channel].period = period_cycles;
+		data->channels[channel].pulse = pulse_cycles;
+		data->stats.reprograms++;
+	}
+
+	k_spin_unlock(&data->lock, key);
+
+	return err;
+}
+
+static int pwm_emul_get_cycles_per_sec(const struct device *dev, uint32_t channel,
+				       uint64_t *cycles)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(channel);
+
+	*cycles = NSEC_PER_SEC;
+
+	return 0;
+}
+
+static const struct pwm_driver_api pwm_emul_api = {
+	.set_cycles = pwm_emul_set_cycles,
+	.get_cycles_per_sec = pwm_emul_get_cycles_per_sec,
+};
+
+void pwm_emul_stats_get(const struct device *dev, struct pwm_emul_stats *stats)
+{
+	struct pwm_emul_data *data = dev->data;
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+	*stats = data->stats;
+
+	k_spin_unlock(&data->lock, key);
+}
+
+int pwm_emul_channel_get(const struct device *dev, uint32_t channel, uint32_t *period,
+			 uint32_t *pulse)
+{
+	const struct pwm_emul_config *config = dev->config;
+	struct pwm_emul_data *data = dev->data;
+	k_spinlock_key_t key;
+
+	if (channel >= config->count) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&data->lock);
+
+	*period = data->channels[channel].period;
+	*pulse = data->channels[channel].pulse;
+
+	k_spin_unlock(&data->lock, key);
+
+	return 0;
+}
+
+#if defined(CONFIG_PM_DEVICE)
+static int pwm_emul_pm_action(const struct device *dev, enum pm_device_action action)
+{
+	const struct pwm_emul_config *config = dev->config;
+	struct pwm_emul_data *data = dev->data;
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+	int err = 0;
+
+	switch (action) {
+	case PM_DEVICE_ACTION_SUSPEND:
+		/* Like the nRF PWM, a stopped controller forgets its outputs. */
+		for (size_t i = 0; i < config->count; i++) {
+			data->channels[i].pulse = 0;
+		}
+		data->suspended = true;
+		data->stats.suspends++;
+		break;
+	case PM_DEVICE_ACTION_RESUME:
+		data->suspended = false;
+		data->stats.resumes++;
+		break;
+	default:
+		err = -ENOTSUP;
+		break;
+	}
+
+	k_spin_unlock(&data->lock, key);
+
+	return err;
+}
+#endif /* CONFIG_PM_DEVICE */
+
+static int pwm_emul_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+#define PWM_EMUL_DEFINE(inst)                                                                      \
+	static struct pwm_emul_channel pwm_emul_channels_##inst[DT_INST_PROP(inst, channels)];     \
+                                                                                                   \
+	static const struct pwm_emul_config pwm_emul_config_##inst = {                             \
+		.count = DT_INST_PROP(inst, channels),                                             \
+	};                                                                                         \
+                                                                                                   \
+	static struct pwm_emul_data pwm_emul_data_##inst = {                                       \
+		.channels = pwm_emul_channels_##inst,                                              \
+	};                                                                                         \
+                                                                                                   \
+	PM_DEVICE_DT_INST_DEFINE(inst, pwm_emul_pm_action);                                        \
+                                                                                                   \
+	DEVICE_DT_INST_DEFINE(inst, pwm_emul_init, PM_DEVICE_DT_INST_GET(inst),                    \
+			      &pwm_emul_data_##inst, &pwm_emul_config_##inst, POST_KERNEL,         \
+			      CONFIG_PWM_INIT_PRIORITY, &pwm_emul_api);
+
+DT_INST_FOREACH_STATUS_OKAY(PWM_EMUL_DEFINE)
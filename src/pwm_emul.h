@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef PWM_EMUL_H_
+#define PWM_EMUL_H_
+
+#include <stdint.h>
+
+#include <zephyr/device.h>
+
+/** Emulated PWM controller counters, summed over all channels. */
+struct pwm_emul_stats {
+	/** Successful pwm_set_cycles() calls. */
+	uint32_t reprograms;
+	/** pwm_set_cycles() calls rejected because the controller was suspended. */
+	uint32_t suspended_writes;
+	/** PM suspend and resume actions taken. */
+	uint32_t suspends;
+	uint32_t resumes;
+};
+
+/** Copy out the controller counters. */
+void pwm_emul_stats_get(const struct device *dev, struct pwm_emul_stats *stats);
+
+/**
+ * Read back the last period and pulse programmed on @p channel, in
+ * nanoseconds.
+ *
+ * @retval -EINVAL Channel out of range.
+ */
+int pwm_emul_channel_get(const struct device *dev, uint32_t channel, uint32_t *period,
+			 uint32_t *pulse);
+
+#endif /* PWM_EMUL_H_ */
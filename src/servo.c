@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define DT_DRV_COMPAT pwm_servo
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/pwm.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/pm/device_runtime.h>
+#include <zephyr/sys/util.h>
+
+#include "bench_host.h"
+#include "motion_profile.h"
+#include "servo.h"
+#include "servo_dt.h"
+
+LOG_MODULE_REGISTER(servo, LOG_LEVEL_INF);
+
+#if defined(CONFIG_APP_BENCH_HOST_CLOCK)
+/* Simulated time stands still during a resume; use host ns instead. */
+#define RESUME_CLOCK() ((uint32_t)bench_host_ns())
+#else
+#define RESUME_CLOCK() k_cycle_get_32()
+#endif
+
+#if defined(CONFIG_APP_MOTION_PROFILE_SCURVE)
+#define MOTION_SHAPE MOTION_SCURVE
+#else
+#define MOTION_SHAPE MOTION_TRAPEZOID
+#endif
+
+struct servo_config {
+	struct pwm_dt_spec pwm;
+	struct servo_lut lut;
+};
+
+struct servo_data {
+	const struct device *dev;
+	/* Serialises angle updates against the park work item. */
+	struct k_mutex lock;
+#if defined(CONFIG_APP_SERVO_MOTION)
+	/* Steps a move, one profile sample per PWM period. */
+	struct k_work_delayable step;
+	/* Speed and acceleration per step of this servo's period. */
+	struct motion_limits limits;
+	struct motion_profile profile;
+	int32_t from_q8;
+	int32_t to_q8;
+	/* Last commanded angle, where the next move starts. */
+	int32_t pos_q8;
+	uint32_t cursor;
+	/* Cleared by an update that cancels the move in progress. */
+	bool moving;
+	/* Nothing was commanded yet, so pos_q8 is not a position. */
+	bool positioned;
+#endif
+#if defined(CONFIG_APP_SERVO_PM)
+	struct k_work_delayable park;
+	/* A runtime PM reference is held on the servo itself. */
+	bool claimed;
+	/* The servo holds a runtime PM reference on the PWM device. */
+	bool pwm_claimed;
+	/* Uptime of the last active/suspended transition. */
+	int64_t since_ms;
+	struct servo_pm_stats stats;
+#endif
+};
+
+#if defined(CONFIG_APP_SERVO_PM)
+#define SERVO_PM_DEFINE(inst) PM_DEVICE_DT_INST_DEFINE(inst, servo_pm_action)
+#define SERVO_PM_GET(inst)    PM_DEVICE_DT_INST_GET(inst)
+#else
+#define SERVO_PM_DEFINE(inst)
+#define SERVO_PM_GET(inst) NULL
+#endif
+
+#define SERVO_DEFINE(inst)                                                                         \
+	SERVO_LUT_DT_CHECK(DT_DRV_INST(inst));                                                     \
+                                                                                                   \
+	static const struct servo_config servo_config_##inst = {                                   \
+		.pwm = PWM_DT_SPEC_INST_GET(inst),                                                 \
+		.lut = SERVO_LUT_DT_INIT(DT_DRV_INST(inst)),                                       \
+	};                                                                                         \
+	static struct servo_data servo_data_##inst;                                                \
+                                                                                                   \
+	SERVO_PM_DEFINE(inst);                                                                     \
+                                                                                                   \
+	DEVICE_DT_INST_DEFINE(inst, servo_init, SERVO_PM_GET(inst), &servo_data_##inst,            \
+			      &servo_config_##inst, POST_KERNEL, CONFIG_APP_SERVO_INIT_PRIORITY,   \
+			      NULL);
+
+uint32_t servo_angle_to_pulse(const struct device *dev, int32_t angle_q8)
+{
+	const struct servo_config *config = dev->config;
+
+	return servo_lut_pulse(&config->lut, angle_q8);
+}
+
+#if defined(CONFIG_APP_SERVO_PM)
+/* Fold the time since the last transition into the active or parked total. */
+static void account(struct servo_data *data, bool was_active)
+{
+	int64_t now = k_uptime_get();
+	uint64_t elapsed = now - data->since_ms;
+
+	if (was_active) {
+		data->stats.active_ms += elapsed;
+	} else {
+		data->stats.suspended_ms += elapsed;
+	}
+
+	data->since_ms = now;
+}
+
+static void servo_park(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct servo_data *data = CONTAINER_OF(dwork, struct servo_data, park);
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+	/*
+	 * An update that won the lock while this item was already running has
+	 * rescheduled it; parking now would cut that pulse off early.
+	 */
+	if (k_work_delayable_is_pending(&data->park)) {
+		k_mutex_unlock(&data->lock);
+		return;
+	}
+
+	if (data->claimed) {
+		(void)pm_device_runtime_put(data->dev);
+		data->claimed = false;
+	}
+
+	k_mutex_unlock(&data->lock);
+}
+
+static int servo_pm_action(const struct device *dev, enum pm_device_action action)
+{
+	const struct servo_config *config = dev->config;
+	struct servo_data *data = dev->data;
+	int err;
+
+	switch (action) {
+	case PM_DEVICE_ACTION_RESUME:
+		/* Brings the PWM back to its default pin state. */
+		err = pm_device_runtime_get(config->pwm.dev);
+		if (err) {
+			return err;
+		}
+
+		data->pwm_claimed = true;
+		account(data, false);
+		data->stats.resumes++;
+		return 0;
+
+	case PM_DEVICE_ACTION_SUSPEND:
+		if (!data->pwm_claimed) {
+			return 0;
+		}
+
+		/*
+		 * Finish the current period low, then let the PWM driver stop
+		 * the peripheral, release HFCLK and apply the sleep pin state.
+		 */
+		(void)pwm_set_pulse_dt(&config->pwm, 0);
+
+		err = pm_device_runtime_put(config->pwm.dev);
+		if (err) {
+			return err;
+		}
+
+		data->pwm_claimed = false;
+		account(data, true);
+		data->stats.suspends++;
+		return 0;
+
+	default:
+		return -ENOTSUP;
+	}
+}
+
+void servo_pm_stats_get(const struct device *dev, struct servo_pm_stats *stats)
+{
+	struct servo_data *data = dev->data;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+	account(data, data->pwm_claimed);
+	*stats = data->stats;
+
+	k_mutex_unlock(&data->lock);
+}
+#endif /* CONFIG_APP_SERVO_PM */
+
+/* Output the pulse for @p angle_q8, resuming the servo if it was parked. */
+static int set_pulse_locked(const struct device *dev, int32_t angle_q8)
+{
+	const struct servo_config *config = dev->config;
+	struct servo_data *data = dev->data;
+	int err;
+
+#if defined(CONFIG_APP_SERVO_PM)
+	uint32_t resume_start = RESUME_CLOCK();
+	bool resumed = !data->claimed;
+
+	if (resumed) {
+		err = pm_device_runtime_get(dev);
+		if (err) {
+			LOG_ERR("Cannot resume %s, err %d", dev->name, err);
+			return err;
+		}
+		data->claimed = true;
+	}
+#endif
+
+	/*
+	 * After a resume the PWM is idle, so the new pulse starts a fresh
+	 * period immediately: the first pulse goes out within one period.
+	 */
+	err = pwm_set_pulse_dt(&config->pwm, servo_lut_pulse(&config->lut, angle_q8));
+
+#if defined(CONFIG_APP_SERVO_PM)
+	if (resumed) {
+		data->stats.resume_cyc_max =
+			MAX(data->stats.resume_cyc_max, RESUME_CLOCK() - resume_start);
+	}
+
+	if (CONFIG_APP_SERVO_HOLD_TIMEOUT_MS > 0) {
+		k_work_reschedule(&data->park, K_MSEC(CONFIG_APP_SERVO_HOLD_TIMEOUT_MS));
+	}
+#endif
+#if defined(CONFIG_APP_SERVO_MOTION)
+	if (!err) {
+		data->pos_q8 = angle_q8;
+		data->positioned = true;
+	}
+#endif
+
+	return err;
+}
+
+int servo_set_angle_q8(const struct device *dev, int32_t angle_q8)
+{
+	struct servo_data *data = dev->data;
+	int err;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+#if defined(CONFIG_APP_SERVO_MOTION)
+	/* A step already running waits on the lock and then sees this. */
+	data->moving = false;
+	(void)k_work_cancel_delayable(&data->step);
+#endif
+
+	err = set_pulse_locked(dev, angle_q8);
+
+	k_mutex_unlock(&data->lock);
+
+	return err;
+}
+
+int servo_set_angle(const struct device *dev, int32_t deg)
+{
+	return servo_set_angle_q8(dev, SERVO_ANGLE_Q8(deg));
+}
+
+#if defined(CONFIG_APP_SERVO_MOTION)
+static void servo_step(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct servo_data *data = CONTAINER_OF(dwork, struct servo_data, step);
+	const struct servo_config *config = data->dev->config;
+	uint32_t progress;
+	int err;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+	if (!data->moving) {
+		k_mutex_unlock(&data->lock);
+		return;
+	}
+
+	progress = motion_profile_progress(&data->profile, data->cursor);
+	err = set_pulse_locked(data->dev,
+			       motion_profile_lerp(data->from_q8, data->to_q8, progress));
+	if (err) {
+		LOG_ERR("Move of %s stopped, err %d", data->dev->name, err);
+		data->moving = false;
+	} else if (data->cursor++ < data->profile.steps) {
+		k_work_reschedule(&data->step, K_NSEC(config->pwm.period));
+	} else {
+		data->moving = false;
+	}
+
+	k_mutex_unlock(&data->lock);
+}
+
+int servo_move_q8(const struct device *dev, int32_t target_q8)
+{
+	const struct servo_config *config = dev->config;
+	struct servo_data *data = dev->data;
+	int err = 0;
+
+	target_q8 = CLAMP(target_q8, config->lut.min_q8, config->lut.max_q8);
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+	if (!data->positioned) {
+		/* Never driven: there is no position to move from. */
+		err = set_pulse_locked(dev, target_q8);
+		goto out;
+	}
+
+	/*
+	 * Start from the last pulse sent, so a move preempted halfway carries
+	 * on from where the servo was told to be.
+	 */
+	data->from_q8 = data->pos_q8;
+	data->to_q8 = target_q8;
+	motion_profile_plan(&data->profile, MOTION_SHAPE, target_q8 - data->from_q8,
+			    &data->limits);
+
+	/* Step 0 is the current position; step 1 goes out right away. */
+	data->cursor = 1;
+	data->moving = true;
+	k_work_reschedule(&data->step, K_NO_WAIT);
+
+out:
+	k_mutex_unlock(&data->lock);
+
+	return err;
+}
+
+int servo_move(const struct device *dev, int32_t deg)
+{
+	return servo_move_q8(dev, SERVO_ANGLE_Q8(deg));
+}
+#endif /* CONFIG_APP_SERVO_MOTION */
+
+static int servo_init(const struct device *dev)
+{
+	const struct servo_config *config = dev->config;
+	struct servo_data *data = dev->data;
+
+	if (!pwm_is_ready_dt(&config->pwm)) {
+		LOG_ERR("PWM device %s is not ready", config->pwm.dev->name);
+		return -ENODEV;
+	}
+
+	data->dev = dev;
+	k_mutex_init(&data->lock);
+
+#if defined(CONFIG_APP_SERVO_MOTION)
+	k_work_init_delayable(&data->step, servo_step);
+	motion_limits_from_rate(&data->limits, CONFIG_APP_MOTION_MAX_SPEED,
+				CONFIG_APP_MOTION_MAX_ACCEL, config->pwm.period / NSEC_PER_USEC);
+#endif
+
+#if defined(CONFIG_APP_SERVO_PM)
+	int err;
+
+	k_work_init_delayable(&data->park, servo_park);
+	data->since_ms = k_uptime_get();
+
+	/*
+	 * The PWM only runs while the servo holds a reference on it, so it
+	 * starts parked in its sleep pin state like the servo itself.
+	 */
+	err = pm_device_runtime_enable(config->pwm.dev);
+	if (err) {
+		LOG_ERR("Cannot enable runtime PM on %s, err %d", config->pwm.dev->name, err);
+		return err;
+	}
+
+	pm_device_init_suspended(dev);
+	return pm_device_runtime_enable(dev);
+#else
+	return 0;
+#endif
+}
+
+DT_INST_FOREACH_STATUS_OKAY(SERVO_DEFINE)
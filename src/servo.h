@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SERVO_H_
+#define SERVO_H_
+
+#include <zephyr/device.h>
+
+#include "servo_lut.h"
+
+/** Runtime power management counters. */
+struct servo_pm_stats {
+	/** Time spent with the PWM running, in milliseconds. */
+	uint64_t active_ms;
+	/** Time spent parked in the PWM sleep state, in milliseconds. */
+	uint64_t suspended_ms;
+	/** Number of times the servo was parked after its hold timeout. */
+	uint32_t suspends;
+	/** Number of times an angle update woke the servo up. */
+	uint32_t resumes;
+	/**
+	 * Longest resume plus first pulse update, in cycles. Host nanoseconds
+	 * with CONFIG_APP_BENCH_HOST_CLOCK.
+	 */
+	uint32_t resume_cyc_max;
+};
+
+/**
+ * Drive the servo to @p deg degrees. The angle is clamped to the
+ * instance's [min-angle, max-angle] range.
+ *
+ * With CONFIG_APP_SERVO_PM the first update after a park resumes the PWM and
+ * the output is parked again CONFIG_APP_SERVO_HOLD_TIMEOUT_MS after the last
+ * update. A parked servo stops driving and no longer holds its position.
+ */
+int servo_set_angle(const struct device *dev, int32_t deg);
+
+/** Same as servo_set_angle() with a Q8 (1/256 degree) angle. */
+int servo_set_angle_q8(const struct device *dev, int32_t angle_q8);
+
+/**
+ * Move the servo to @p deg degrees along a motion profile, one pulse update
+ * per PWM period from the system workqueue. The first step goes out right
+ * away. A call during a move replans it from the last pulse sent;
+ * servo_set_angle() cancels it. A servo that was never driven jumps to
+ * @p deg.
+ *
+ * Only available with CONFIG_APP_SERVO_MOTION.
+ */
+int servo_move(const struct device *dev, int32_t deg);
+
+/** Same as servo_move() with a Q8 (1/256 degree) angle. */
+int servo_move_q8(const struct device *dev, int32_t target_q8);
+
+/** Resolve a Q8 angle to its pulse width without touching the PWM. */
+uint32_t servo_angle_to_pulse(const struct device *dev, int32_t angle_q8);
+
+/** Copy out the runtime PM counters. Only available with CONFIG_APP_SERVO_PM. */
+void servo_pm_stats_get(const struct device *dev, struct servo_pm_stats *stats);
+
+#endif /* SERVO_H_ */
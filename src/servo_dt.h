@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SERVO_DT_H_
+#define SERVO_DT_H_
+
+#include <zephyr/devicetree.h>
+#include <zephyr/sys/util.h>
+
+#include "servo_lut.h"
+
+/*
+ * Build-time table generation. Every table entry is an integer constant
+ * expression, so the per-instance table lands in flash and no division is
+ * ever executed at run time.
+ */
+
+/* Q8 angle of table entry k. */
+#define SERVO_ENTRY_ANGLE(node_id, k)                                                              \
+	(SERVO_ANGLE_Q8(DT_PROP(node_id, min_angle)) +                                             \
+	 (SERVO_ANGLE_Q8(DT_PROP(node_id, max_angle) - DT_PROP(node_id, min_angle)) * (k)) /       \
+		 SERVO_LUT_SEGMENTS)
+
+#define SERVO_CAL_ANGLE(node_id, i) SERVO_ANGLE_Q8(DT_PROP_BY_IDX(node_id, calibration_angles, i))
+#define SERVO_CAL_PULSE(node_id, i) DT_PROP_BY_IDX(node_id, calibration_pulses, i)
+
+/* "x <= a[j] ? lerp(i, j) :" when calibration point j exists, else nothing. */
+#define SERVO_CAL_SEGMENT(i, j, node_id, x)                                                        \
+	COND_CODE_1(DT_PROP_HAS_IDX(node_id, calibration_angles, j),                               \
+		    (((x) <= SERVO_CAL_ANGLE(node_id, j))                                          \
+			     ? SERVO_LUT_LERP(SERVO_CAL_ANGLE(node_id, i),                         \
+					      SERVO_CAL_PULSE(node_id, i),                         \
+					      SERVO_CAL_ANGLE(node_id, j),                         \
+					      SERVO_CAL_PULSE(node_id, j), x)                      \
+			     :),                                                                   \
+		    ())
+
+#define SERVO_CAL_POINTS_MAX 8
+
+#define SERVO_PULSE_CALIBRATED(node_id, x)                                                         \
+	(SERVO_CAL_SEGMENT(0, 1, node_id, x) SERVO_CAL_SEGMENT(1, 2, node_id, x)                   \
+		 SERVO_CAL_SEGMENT(2, 3, node_id, x) SERVO_CAL_SEGMENT(3, 4, node_id, x)           \
+			 SERVO_CAL_SEGMENT(4, 5, node_id, x) SERVO_CAL_SEGMENT(5, 6, node_id, x)   \
+				 SERVO_CAL_SEGMENT(6, 7, node_id, x) DT_PROP(node_id, max_pulse))
+
+#define SERVO_PULSE_LINEAR(node_id, x)                                                             \
+	SERVO_LUT_LERP(SERVO_ANGLE_Q8(DT_PROP(node_id, min_angle)), DT_PROP(node_id, min_pulse),   \
+		       SERVO_ANGLE_Q8(DT_PROP(node_id, max_angle)), DT_PROP(node_id, max_pulse), x)
+
+#define SERVO_PULSE_AT(node_id, x)                                                                 \
+	COND_CODE_1(DT_NODE_HAS_PROP(node_id, calibration_angles),                                 \
+		    (SERVO_PULSE_CALIBRATED(node_id, x)), (SERVO_PULSE_LINEAR(node_id, x)))
+
+#define SERVO_LUT_ENTRY(k, node_id) SERVO_PULSE_AT(node_id, SERVO_ENTRY_ANGLE(node_id, k))
+
+/* "a[j] > a[i] &&" when calibration point j exists, else nothing. */
+#define SERVO_CAL_ASCENDS(i, j, node_id)                                                           \
+	COND_CODE_1(DT_PROP_HAS_IDX(node_id, calibration_angles, j),                               \
+		    ((DT_PROP_BY_IDX(node_id, calibration_angles, j) >                             \
+		      DT_PROP_BY_IDX(node_id, calibration_angles, i)) &&),                         \
+		    ())
+
+/* "+ a[i]" when i is the last calibration point, else nothing. */
+#define SERVO_CAL_LAST(i, j, node_id)                                                              \
+	COND_CODE_1(DT_PROP_HAS_IDX(node_id, calibration_angles, i),                               \
+		    (COND_CODE_1(DT_PROP_HAS_IDX(node_id, calibration_angles, j), (),              \
+				 (+DT_PROP_BY_IDX(node_id, calibration_angles, i)))),              \
+		    ())
+
+#define SERVO_CHECK_CALIBRATION(node_id)                                                           \
+	BUILD_ASSERT(DT_PROP_LEN(node_id, calibration_angles) ==                                   \
+			     DT_PROP_LEN(node_id, calibration_pulses),                             \
+		     "calibration-angles and calibration-pulses differ in length");                \
+	BUILD_ASSERT(DT_PROP_LEN(node_id, calibration_angles) >= 2 &&                              \
+			     DT_PROP_LEN(node_id, calibration_angles) <= SERVO_CAL_POINTS_MAX,     \
+		     "calibration-angles must hold 2 to 8 points");                                \
+	BUILD_ASSERT(DT_PROP_BY_IDX(node_id, calibration_angles, 0) ==                             \
+			     DT_PROP(node_id, min_angle),                                          \
+		     "calibration-angles must start at min-angle");                                \
+	BUILD_ASSERT((0 SERVO_CAL_LAST(0, 1, node_id) SERVO_CAL_LAST(1, 2, node_id)                \
+			      SERVO_CAL_LAST(2, 3, node_id) SERVO_CAL_LAST(3, 4, node_id)          \
+				      SERVO_CAL_LAST(4, 5, node_id) SERVO_CAL_LAST(5, 6, node_id)  \
+					      SERVO_CAL_LAST(6, 7, node_id)                        \
+						      SERVO_CAL_LAST(7, 8, node_id)) ==            \
+			     DT_PROP(node_id, max_angle),                                          \
+		     "calibration-angles must end at max-angle");                                  \
+	BUILD_ASSERT(SERVO_CAL_ASCENDS(0, 1, node_id) SERVO_CAL_ASCENDS(1, 2, node_id)             \
+			     SERVO_CAL_ASCENDS(2, 3, node_id) SERVO_CAL_ASCENDS(3, 4, node_id)     \
+				     SERVO_CAL_ASCENDS(4, 5, node_id)                              \
+					     SERVO_CAL_ASCENDS(5, 6, node_id)                      \
+						     SERVO_CAL_ASCENDS(6, 7, node_id) 1,           \
+		     "calibration-angles must be strictly ascending");
+
+/** Build-time checks for a node using the pwm-servo angle/pulse properties. */
+#define SERVO_LUT_DT_CHECK(node_id)                                                                \
+	IF_ENABLED(DT_NODE_HAS_PROP(node_id, calibration_angles),                                  \
+		   (SERVO_CHECK_CALIBRATION(node_id)))                                             \
+	BUILD_ASSERT(DT_PROP(node_id, max_angle) > DT_PROP(node_id, min_angle),                    \
+		     "max-angle must be greater than min-angle")
+
+/** Initializer for a struct servo_lut built from a node's properties. */
+#define SERVO_LUT_DT_INIT(node_id)                                                                 \
+	{                                                                                          \
+		.min_q8 = SERVO_ANGLE_Q8(DT_PROP(node_id, min_angle)),                             \
+		.max_q8 = SERVO_ANGLE_Q8(DT_PROP(node_id, max_angle)),                             \
+		.scale = SERVO_LUT_SCALE(DT_PROP(node_id, max_angle) -                             \
+					 DT_PROP(node_id, min_angle)),                             \
+		.pulse = {LISTIFY(SERVO_LUT_ENTRIES, SERVO_LUT_ENTRY, (,), node_id)},              \
+	}
+
+#endif /* SERVO_DT_H_ */
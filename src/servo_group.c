@@ -0,0 +1,647 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define DT_DRV_COMPAT pwm_servo_group
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/pinctrl.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/pm/device_runtime.h>
+#include <zephyr/sys/util.h>
+#include <nrfx_pwm.h>
+#include <hal/nrf_pwm.h>
+
+#include "motion_profile.h"
+#include "servo_dt.h"
+#include "servo_group.h"
+
+LOG_MODULE_REGISTER(servo_group, LOG_LEVEL_INF);
+
+#define PWM_CHANNELS NRF_PWM_CHANNEL_COUNT
+
+/* COUNTERTOP is 15 bits wide. */
+#define PWM_TOP_MAX 0x7FFF
+
+/* Bit 15 of a compare value selects the polarity; set means active high. */
+#define PWM_POLARITY_HIGH BIT(15)
+
+/* nrfx instance index of a nordic,nrf-pwm node. */
+#define PWM_NRFX_IDX(node_id)                                                                      \
+	COND_CODE_1(DT_SAME_NODE(node_id, DT_NODELABEL(pwm0)), (0),                                \
+	(COND_CODE_1(DT_SAME_NODE(node_id, DT_NODELABEL(pwm1)), (1),                               \
+	(COND_CODE_1(DT_SAME_NODE(node_id, DT_NODELABEL(pwm2)), (2), (3))))))
+
+#define SEG_PERIODS CONFIG_APP_MOTION_SEGMENT_PERIODS
+
+#define SEQEND_INT_MASK (NRF_PWM_INT_SEQEND0_MASK | NRF_PWM_INT_SEQEND1_MASK)
+
+#if defined(CONFIG_APP_MOTION_PROFILE_SCURVE)
+#define MOTION_SHAPE MOTION_SCURVE
+#else
+#define MOTION_SHAPE MOTION_TRAPEZOID
+#endif
+
+enum motion_state {
+	/* Holding position on the one-period sequences, SEQEND masked. */
+	MOTION_IDLE,
+	/* Waiting for SEQEND0 to hand both sequences over to the segments. */
+	MOTION_ARMING,
+	/* Segments playing; each SEQENDn refills the segment just finished. */
+	MOTION_RUNNING,
+};
+
+struct servo_group_config {
+	nrfx_pwm_t pwm;
+	void (*irq_connect)(void);
+	const struct pinctrl_dev_config *pcfg;
+	uint8_t irq_priority;
+	/* Period in 1 MHz PWM clock ticks. */
+	uint16_t top;
+	uint8_t count;
+	const uint8_t *channels;
+	const struct servo_lut *luts;
+};
+
+struct servo_group_data {
+	/* EasyDMA source; one half plays while the other is rewritten. */
+	nrf_pwm_values_individual_t values[2];
+	uint8_t active;
+	bool running;
+	/* Serialises updates against the PWM interrupt. */
+	struct k_spinlock lock;
+#if defined(CONFIG_APP_SERVO_MOTION)
+	/* Motion segments, one per PWM sequence, SEG_PERIODS periods each. */
+	nrf_pwm_values_individual_t seg[2][SEG_PERIODS];
+	enum motion_state state;
+	struct motion_profile profile;
+	/* Next profile step to be written into a segment. */
+	uint32_t cursor;
+	int32_t from_q8[NRF_PWM_CHANNEL_COUNT];
+	int32_t to_q8[NRF_PWM_CHANNEL_COUNT];
+	/* Angle of the last sample handed to the peripheral. */
+	int32_t pos_q8[NRF_PWM_CHANNEL_COUNT];
+	int32_t pending_q8[NRF_PWM_CHANNEL_COUNT];
+	bool pending;
+	/* Speed and acceleration per step of this group's period. */
+	struct motion_limits limits;
+#endif
+#if defined(CONFIG_APP_SERVO_GROUP_PM)
+	const struct device *dev;
+	/* Serialises claiming the PWM against the park work item. */
+	struct k_mutex pm_lock;
+	struct k_work_delayable park;
+	/* A runtime PM reference is held on the group. */
+	bool claimed;
+#endif
+	struct servo_group_stats stats;
+};
+
+#if defined(CONFIG_APP_SERVO_GROUP_PM)
+#define SERVO_GROUP_PM_DEFINE(inst) PM_DEVICE_DT_INST_DEFINE(inst, servo_group_pm_action)
+#define SERVO_GROUP_PM_GET(inst)    PM_DEVICE_DT_INST_GET(inst)
+#else
+#define SERVO_GROUP_PM_DEFINE(inst)
+#define SERVO_GROUP_PM_GET(inst) NULL
+#endif
+
+static uint16_t *values_of(struct servo_group_data *data, uint8_t idx)
+{
+	return (uint16_t *)&data->values[idx];
+}
+
+size_t servo_group_size(const struct device *dev)
+{
+	const struct servo_group_config *config = dev->config;
+
+	return config->count;
+}
+
+static uint16_t to_compare(const struct servo_lut *lut, int32_t angle_q8)
+{
+	return (servo_lut_pulse(lut, angle_q8) / NSEC_PER_USEC) | PWM_POLARITY_HIGH;
+}
+
+static void start_hold(const struct device *dev, nrf_pwm_values_individual_t *values)
+{
+	const struct servo_group_config *config = dev->config;
+	struct servo_group_data *data = dev->data;
+	nrf_pwm_sequence_t seq = {
+		.values.p_individual = values,
+		.length = NRF_PWM_VALUES_LENGTH(*values),
+		.repeats = 0,
+		.end_delay = 0,
+	};
+	uint32_t flags = NRFX_PWM_FLAG_LOOP | NRFX_PWM_FLAG_NO_EVT_FINISHED;
+
+	if (IS_ENABLED(CONFIG_APP_SERVO_MOTION)) {
+		/*
+		 * nrfx only forwards SEQEND events it was asked to signal.
+		 * Request both, then mask them until a move needs them.
+		 */
+		flags |= NRFX_PWM_FLAG_SIGNAL_END_SEQ0 | NRFX_PWM_FLAG_SIGNAL_END_SEQ1;
+	}
+
+	(void)nrfx_pwm_simple_playback(&config->pwm, &seq, 1, flags);
+	nrf_pwm_int_disable(config->pwm.p_reg, SEQEND_INT_MASK);
+
+	data->running = true;
+	data->stats.starts++;
+}
+
+/* Point both sequences at a hold buffer; caller holds data->lock. */
+static void set_hold_locked(const struct device *dev, const int32_t *angle_q8)
+{
+	const struct servo_group_config *config = dev->config;
+	struct servo_group_data *data = dev->data;
+	uint8_t next = data->active ^ 1;
+	uint16_t *values = values_of(data, next);
+	bool was_moving = false;
+
+	for (size_t i = 0; i < config->count; i++) {
+		values[config->channels[i]] = to_compare(&config->luts[i], angle_q8[i]);
+	}
+
+#if defined(CONFIG_APP_SERVO_MOTION)
+	was_moving = data->state != MOTION_IDLE;
+	if (was_moving) {
+		nrf_pwm_int_disable(config->pwm.p_reg, SEQEND_INT_MASK);
+		data->state = MOTION_IDLE;
+	}
+	data->pending = false;
+	memcpy(data->pos_q8, angle_q8, config->count * sizeof(angle_q8[0]));
+#endif
+
+	if (!data->running) {
+		start_hold(dev, &data->values[next]);
+	} else {
+		/*
+		 * Both sequences of the looped playback point at the same
+		 * buffer. SEQ[n].PTR and SEQ[n].CNT are latched on every
+		 * sequence start, so the next period loads all four channels
+		 * from the new half.
+		 *
+		 * Coming off a move, shrink CNT before repointing PTR: a
+		 * sequence start in between must never latch the one-period
+		 * buffer with a segment-long count, or EasyDMA would read past
+		 * it.
+		 */
+		if (was_moving) {
+			nrf_pwm_seq_cnt_set(config->pwm.p_reg, 0, NRF_PWM_CHANNEL_COUNT);
+			nrf_pwm_seq_cnt_set(config->pwm.p_reg, 1, NRF_PWM_CHANNEL_COUNT);
+			data->stats.reg_writes += 2;
+		}
+
+		nrf_pwm_seq_ptr_set(config->pwm.p_reg, 0, values);
+		nrf_pwm_seq_ptr_set(config->pwm.p_reg, 1, values);
+		data->stats.reg_writes += 2;
+	}
+
+	data->active = next;
+	data->stats.updates++;
+}
+
+#if defined(CONFIG_APP_SERVO_GROUP_PM)
+/* Resume a parked group before an update; caller holds data->pm_lock. */
+static int claim_locked(const struct device *dev)
+{
+	struct servo_group_data *data = dev->data;
+	int err;
+
+	if (data->claimed) {
+		return 0;
+	}
+
+	err = pm_device_runtime_get(dev);
+	if (err) {
+		LOG_ERR("Cannot resume %s, err %d", dev->name, err);
+		return err;
+	}
+
+	data->claimed = true;
+	return 0;
+}
+
+static void servo_group_park(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct servo_group_data *data = CONTAINER_OF(dwork, struct servo_group_data, park);
+
+	k_mutex_lock(&data->pm_lock, K_FOREVER);
+
+	/* Rescheduled by an update that won the lock while this item ran. */
+	if (k_work_delayable_is_pending(&data->park)) {
+		goto out;
+	}
+
+#if defined(CONFIG_APP_SERVO_MOTION)
+	/* Only moves started under pm_lock leave MOTION_IDLE. */
+	if (data->state != MOTION_IDLE) {
+		k_work_reschedule(&data->park, K_MSEC(CONFIG_APP_SERVO_HOLD_TIMEOUT_MS));
+		goto out;
+	}
+#endif
+
+	if (data->claimed) {
+		(void)pm_device_runtime_put(data->dev);
+		data->claimed = false;
+	}
+
+out:
+	k_mutex_unlock(&data->pm_lock);
+}
+
+static int servo_group_pm_action(const struct device *dev, enum pm_device_action action)
+{
+	const struct servo_group_config *config = dev->config;
+	struct servo_group_data *data = dev->data;
+	k_spinlock_key_t key;
+
+	switch (action) {
+	case PM_DEVICE_ACTION_RESUME:
+		/* The next update restarts playback on a fresh period. */
+		return pinctrl_apply_state(config->pcfg, PINCTRL_STATE_DEFAULT);
+
+	case PM_DEVICE_ACTION_SUSPEND:
+		/*
+		 * STOP takes effect at the end of the period in progress, so
+		 * no servo sees a cut-short pulse; this waits up to one period.
+		 * A stopped PWM no longer requests HFCLK.
+		 */
+		(void)nrfx_pwm_stop(&config->pwm, true);
+
+		key = k_spin_lock(&data->lock);
+		data->running = false;
+		data->stats.parks++;
+		k_spin_unlock(&data->lock, key);
+
+		return pinctrl_apply_state(config->pcfg, PINCTRL_STATE_SLEEP);
+
+	default:
+		return -ENOTSUP;
+	}
+}
+#endif /* CONFIG_APP_SERVO_GROUP_PM */
+
+int servo_group_set_angles_q8(const struct device *dev, const int32_t *angle_q8, size_t count)
+{
+	const struct servo_group_config *config = dev->config;
+	struct servo_group_data *data = dev->data;
+	k_spinlock_key_t key;
+	int err = 0;
+
+	if (count != config->count) {
+		return -EINVAL;
+	}
+
+#if defined(CONFIG_APP_SERVO_GROUP_PM)
+	k_mutex_lock(&data->pm_lock, K_FOREVER);
+
+	err = claim_locked(dev);
+	if (err) {
+		goto out;
+	}
+#endif
+
+	key = k_spin_lock(&data->lock);
+	set_hold_locked(dev, angle_q8);
+	k_spin_unlock(&data->lock, key);
+
+#if defined(CONFIG_APP_SERVO_GROUP_PM)
+	if (CONFIG_APP_SERVO_HOLD_TIMEOUT_MS > 0) {
+		k_work_reschedule(&data->park, K_MSEC(CONFIG_APP_SERVO_HOLD_TIMEOUT_MS));
+	}
+out:
+	k_mutex_unlock(&data->pm_lock);
+#endif
+
+	return err;
+}
+
+#if defined(CONFIG_APP_SERVO_MOTION)
+/* Plan a move from the last commanded position to the pending target. */
+static void motion_begin(const struct device *dev)
+{
+	const struct servo_group_config *config = dev->config;
+	struct servo_group_data *data = dev->data;
+	int32_t longest = 0;
+
+	for (size_t i = 0; i < config->count; i++) {
+		int32_t dist = data->pending_q8[i] - data->pos_q8[i];
+
+		data->from_q8[i] = data->pos_q8[i];
+		data->to_q8[i] = data->pending_q8[i];
+		longest = MAX(longest, dist < 0 ? -dist : dist);
+	}
+
+	motion_profile_plan(&data->profile, MOTION_SHAPE, longest, &data->limits);
+
+	/* Step 0 is the current position, which is already playing. */
+	data->cursor = 1;
+	data->pending = false;
+	data->stats.moves++;
+}
+
+static void motion_fill(const struct device *dev, nrf_pwm_values_individual_t *seg)
+{
+	const struct servo_group_config *config = dev->config;
+	struct servo_group_data *data = dev->data;
+
+	for (size_t j = 0; j < SEG_PERIODS; j++) {
+		uint16_t *values = (uint16_t *)&seg[j];
+		uint32_t progress = motion_profile_progress(&data->profile, data->cursor++);
+
+		for (size_t i = 0; i < config->count; i++) {
+			int32_t angle_q8 =
+				motion_profile_lerp(data->from_q8[i], data->to_q8[i], progress);
+
+			values[config->channels[i]] = to_compare(&config->luts[i], angle_q8);
+			data->pos_q8[i] = angle_q8;
+		}
+	}
+}
+
+static void servo_group_pwm_handler(nrfx_pwm_evt_type_t event, void *context)
+{
+	const struct device *dev = context;
+	const struct servo_group_config *config = dev->config;
+	struct servo_group_data *data = dev->data;
+	NRF_PWM_Type *reg = config->pwm.p_reg;
+	uint8_t finished;
+	k_spinlock_key_t key;
+
+	if (event == NRFX_PWM_EVT_END_SEQ0) {
+		finished = 0;
+	} else if (event == NRFX_PWM_EVT_END_SEQ1) {
+		finished = 1;
+	} else {
+		return;
+	}
+
+	key = k_spin_lock(&data->lock);
+
+	data->stats.segment_irqs++;
+
+	switch (data->state) {
+	case MOTION_ARMING:
+		if (finished != 0) {
+			break;
+		}
+
+		/*
+		 * SEQ1 has just started on the hold buffer. Queue the first
+		 * segment so SEQ0 plays it right after. seg[1] is filled by
+		 * the SEQEND1 that ends this hold period: SEQ1 does not latch
+		 * it before seg[0] has played out.
+		 */
+		motion_begin(dev);
+		motion_fill(dev, data->seg[0]);
+		for (uint8_t n = 0; n < 2; n++) {
+			nrf_pwm_seq_ptr_set(reg, n, (uint16_t *)data->seg[n]);
+			nrf_pwm_seq_cnt_set(reg, n, SEG_PERIODS * NRF_PWM_CHANNEL_COUNT);
+		}
+		nrf_pwm_event_clear(reg, NRF_PWM_EVENT_SEQEND1);
+		nrf_pwm_int_enable(reg, NRF_PWM_INT_SEQEND1_MASK);
+		data->state = MOTION_RUNNING;
+		break;
+
+	case MOTION_RUNNING:
+		if (data->pending) {
+			/* Preempt: continue from the end of the playing segment. */
+			motion_begin(dev);
+		} else if (data->cursor > data->profile.steps) {
+			/*
+			 * The playing segment ends on the target. Park both
+			 * sequences on a hold buffer; it is picked up right
+			 * after, and no SEQEND interrupt fires while holding.
+			 */
+			set_hold_locked(dev, data->to_q8);
+			break;
+		}
+
+		motion_fill(dev, data->seg[finished]);
+		break;
+
+	default:
+		break;
+	}
+
+	k_spin_unlock(&data->lock, key);
+}
+
+int servo_group_move_q8(const struct device *dev, const int32_t *target_q8, size_t count)
+{
+	const struct servo_group_config *config = dev->config;
+	struct servo_group_data *data = dev->data;
+	k_spinlock_key_t key;
+	int err = 0;
+
+	if (count != config->count) {
+		return -EINVAL;
+	}
+
+#if defined(CONFIG_APP_SERVO_GROUP_PM)
+	k_mutex_lock(&data->pm_lock, K_FOREVER);
+
+	err = claim_locked(dev);
+	if (err) {
+		goto out;
+	}
+#endif
+
+	key = k_spin_lock(&data->lock);
+
+	if (!data->running && data->stats.starts == 0) {
+		/* Never driven: there is no position to move from. */
+		set_hold_locked(dev, target_q8);
+	} else {
+		if (!data->running) {
+			/*
+			 * Parked. Only a finished move or an update parks, so
+			 * the active hold buffer still holds pos_q8: play it
+			 * again and move away from it once SEQEND0 arms.
+			 */
+			start_hold(dev, &data->values[data->active]);
+		}
+
+		memcpy(data->pending_q8, target_q8, count * sizeof(target_q8[0]));
+		data->pending = true;
+
+		if (data->state == MOTION_IDLE) {
+			nrf_pwm_event_clear(config->pwm.p_reg, NRF_PWM_EVENT_SEQEND0);
+			nrf_pwm_int_enable(config->pwm.p_reg, NRF_PWM_INT_SEQEND0_MASK);
+			data->state = MOTION_ARMING;
+		}
+	}
+
+	k_spin_unlock(&data->lock, key);
+
+#if defined(CONFIG_APP_SERVO_GROUP_PM)
+	/* servo_group_park() waits for the move to end before counting down. */
+	if (CONFIG_APP_SERVO_HOLD_TIMEOUT_MS > 0) {
+		k_work_reschedule(&data->park, K_MSEC(CONFIG_APP_SERVO_HOLD_TIMEOUT_MS));
+	}
+out:
+	k_mutex_unlock(&data->pm_lock);
+#endif
+
+	return err;
+}
+
+int servo_group_move_all(const struct device *dev, int32_t deg)
+{
+	const struct servo_group_config *config = dev->config;
+	int32_t angle_q8[PWM_CHANNELS];
+
+	for (size_t i = 0; i < config->count; i++) {
+		angle_q8[i] = SERVO_ANGLE_Q8(deg);
+	}
+
+	return servo_group_move_q8(dev, angle_q8, config->count);
+}
+#endif /* CONFIG_APP_SERVO_MOTION */
+
+int servo_group_set_all(const struct device *dev, int32_t deg)
+{
+	const struct servo_group_config *config = dev->config;
+	int32_t angle_q8[PWM_CHANNELS];
+
+	for (size_t i = 0; i < config->count; i++) {
+		angle_q8[i] = SERVO_ANGLE_Q8(deg);
+	}
+
+	return servo_group_set_angles_q8(dev, angle_q8, config->count);
+}
+
+void servo_group_stats_get(const struct device *dev, struct servo_group_stats *stats)
+{
+	struct servo_group_data *data = dev->data;
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+	*stats = data->stats;
+
+	k_spin_unlock(&data->lock, key);
+}
+
+static int servo_group_init(const struct device *dev)
+{
+	const struct servo_group_config *config = dev->config;
+	struct servo_group_data *data = dev->data;
+	nrfx_pwm_config_t pwm_config = {
+		.output_pins = {
+			NRF_PWM_PIN_NOT_CONNECTED,
+			NRF_PWM_PIN_NOT_CONNECTED,
+			NRF_PWM_PIN_NOT_CONNECTED,
+			NRF_PWM_PIN_NOT_CONNECTED,
+		},
+		.irq_priority = config->irq_priority,
+		.base_clock = NRF_PWM_CLK_1MHz,
+		.count_mode = NRF_PWM_MODE_UP,
+		.top_value = config->top,
+		.load_mode = NRF_PWM_LOAD_INDIVIDUAL,
+		.step_mode = NRF_PWM_STEP_AUTO,
+		.skip_gpio_cfg = true,
+		.skip_psel_cfg = true,
+	};
+	nrfx_pwm_handler_t handler = NULL;
+	nrfx_err_t result;
+	int err;
+
+#if defined(CONFIG_APP_SERVO_MOTION)
+	motion_limits_from_rate(&data->limits, CONFIG_APP_MOTION_MAX_SPEED,
+				CONFIG_APP_MOTION_MAX_ACCEL, config->top);
+	handler = servo_group_pwm_handler;
+	config->irq_connect();
+#endif
+
+	/* Unused channels stay low. */
+	for (size_t i = 0; i < PWM_CHANNELS; i++) {
+		values_of(data, 0)[i] = PWM_POLARITY_HIGH;
+		values_of(data, 1)[i] = PWM_POLARITY_HIGH;
+	}
+
+	/* With runtime PM the group starts parked, pins in their sleep state. */
+	err = pinctrl_apply_state(config->pcfg, IS_ENABLED(CONFIG_APP_SERVO_GROUP_PM)
+							? PINCTRL_STATE_SLEEP
+							: PINCTRL_STATE_DEFAULT);
+	if (err) {
+		LOG_ERR("Cannot apply pinctrl state, err %d", err);
+		return err;
+	}
+
+	result = nrfx_pwm_init(&config->pwm, &pwm_config, handler, (void *)dev);
+	if (result != NRFX_SUCCESS) {
+		LOG_ERR("nrfx_pwm_init returned 0x%08x", result);
+		return -EBUSY;
+	}
+
+#if defined(CONFIG_APP_SERVO_GROUP_PM)
+	data->dev = dev;
+	k_mutex_init(&data->pm_lock);
+	k_work_init_delayable(&data->park, servo_group_park);
+
+	pm_device_init_suspended(dev);
+	return pm_device_runtime_enable(dev);
+#else
+	return 0;
+#endif
+}
+
+#define SERVO_GROUP_CHILD_CHECK(node_id)                                                           \
+	SERVO_LUT_DT_CHECK(node_id);                                                               \
+	BUILD_ASSERT(DT_REG_ADDR(node_id) < PWM_CHANNELS, "servo group channel out of range");
+
+#define SERVO_GROUP_CHANNEL(node_id) DT_REG_ADDR(node_id),
+#define SERVO_GROUP_LUT(node_id)     SERVO_LUT_DT_INIT(node_id),
+
+#define SERVO_GROUP_DEFINE(inst)                                                                   \
+	BUILD_ASSERT(DT_NODE_HAS_STATUS(DT_INST_PHANDLE(inst, pwm), disabled),                     \
+		     "servo group PWM must be disabled for the Zephyr PWM driver");                \
+	BUILD_ASSERT(DT_INST_PROP(inst, period) / NSEC_PER_USEC <= PWM_TOP_MAX,                    \
+		     "servo group period too long for a 1 MHz PWM clock");                         \
+	DT_INST_FOREACH_CHILD(inst, SERVO_GROUP_CHILD_CHECK)                                       \
+                                                                                                   \
+	PINCTRL_DT_DEFINE(DT_INST_PHANDLE(inst, pwm));                                             \
+                                                                                                   \
+	static void servo_group_irq_connect_##inst(void)                                           \
+	{                                                                                          \
+		IRQ_CONNECT(DT_IRQN(DT_INST_PHANDLE(inst, pwm)),                                   \
+			    DT_IRQ(DT_INST_PHANDLE(inst, pwm), priority), nrfx_isr,                \
+			    NRFX_CONCAT_3(nrfx_pwm_, PWM_NRFX_IDX(DT_INST_PHANDLE(inst, pwm)),     \
+					  _irq_handler),                                           \
+			    0);                                                                    \
+	}                                                                                          \
+                                                                                                   \
+	static const uint8_t servo_group_channels_##inst[] = {                                     \
+		DT_INST_FOREACH_CHILD(inst, SERVO_GROUP_CHANNEL)};                                 \
+	static const struct servo_lut servo_group_luts_##inst[] = {                                \
+		DT_INST_FOREACH_CHILD(inst, SERVO_GROUP_LUT)};                                     \
+	BUILD_ASSERT(ARRAY_SIZE(servo_group_channels_##inst) <= PWM_CHANNELS,                      \
+		     "servo group has more servos than PWM channels");                             \
+                                                                                                   \
+	static const struct servo_group_config servo_group_config_##inst = {                       \
+		.pwm = NRFX_PWM_INSTANCE(PWM_NRFX_IDX(DT_INST_PHANDLE(inst, pwm))),                \
+		.irq_connect = servo_group_irq_connect_##inst,                                     \
+		.pcfg = PINCTRL_DT_DEV_CONFIG_GET(DT_INST_PHANDLE(inst, pwm)),                     \
+		.irq_priority = DT_IRQ(DT_INST_PHANDLE(inst, pwm), priority),                      \
+		.top = DT_INST_PROP(inst, period) / NSEC_PER_USEC,                                 \
+		.count = ARRAY_SIZE(servo_group_channels_##inst),                                  \
+		.channels = servo_group_channels_##inst,                                           \
+		.luts = servo_group_luts_##inst,                                                   \
+	};                                                                                         \
+	static struct servo_group_data servo_group_data_##inst;                                    \
+                                                                                                   \
+	SERVO_GROUP_PM_DEFINE(inst);                                                               \
+                                                                                                   \
+	DEVICE_DT_INST_DEFINE(inst, servo_group_init, SERVO_GROUP_PM_GET(inst),                    \
+			      &servo_group_data_##inst, &servo_group_config_##inst, POST_KERNEL,   \
+			      CONFIG_APP_SERVO_INIT_PRIORITY, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(SERVO_GROUP_DEFINE)
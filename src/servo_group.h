@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SERVO_GROUP_H_
+#define SERVO_GROUP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+
+/** Servo group update counters. */
+struct servo_group_stats {
+	/** Calls to servo_group_set_angles*() that reached the peripheral. */
+	uint32_t updates;
+	/** Full playback starts (first update, or after a stop). */
+	uint32_t starts;
+	/** Peripheral register writes done by updates of a running group. */
+	uint32_t reg_writes;
+	/** Profiled moves started, including preempting ones. */
+	uint32_t moves;
+	/** PWM interrupts taken at motion segment boundaries. */
+	uint32_t segment_irqs;
+	/** Times the PWM was stopped after the hold timeout. */
+	uint32_t parks;
+};
+
+/** Number of servos in the group. */
+size_t servo_group_size(const struct device *dev);
+
+/**
+ * Move every servo of the group in the same PWM period.
+ *
+ * The new compare values are written to the idle half of a double buffer
+ * and the sequence pointers are swapped, so the peripheral picks up all
+ * channels on one EasyDMA load. Not reentrant: call from a single thread.
+ *
+ * @param angle_q8 One Q8 angle per servo, in devicetree child order.
+ * @param count    Must equal servo_group_size().
+ */
+int servo_group_set_angles_q8(const struct device *dev, const int32_t *angle_q8, size_t count);
+
+/** Same as servo_group_set_angles_q8() with every servo set to @p deg. */
+int servo_group_set_all(const struct device *dev, int32_t deg);
+
+/**
+ * Move every servo of the group to @p target_q8 along a motion profile.
+ *
+ * The profile is rendered segment by segment into two EasyDMA buffers that
+ * the PWM plays back on its own; the CPU is only interrupted at segment
+ * boundaries. The move starts within two PWM periods. A call during a move
+ * preempts it at the next segment boundary, continuing from the position
+ * reached there. servo_group_set_angles_q8() cancels a move. A group that
+ * was parked by runtime PM resumes on its last position and moves from
+ * there; one that was never driven jumps to @p target_q8.
+ *
+ * Only available with CONFIG_APP_SERVO_MOTION.
+ */
+int servo_group_move_q8(const struct device *dev, const int32_t *target_q8, size_t count);
+
+/** Same as servo_group_move_q8() with every servo moving to @p deg. */
+int servo_group_move_all(const struct device *dev, int32_t deg);
+
+/** Copy out the update counters. */
+void servo_group_stats_get(const struct device *dev, struct servo_group_stats *stats);
+
+#endif /* SERVO_GROUP_H_ */
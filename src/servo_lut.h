@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SERVO_LUT_H_
+#define SERVO_LUT_H_
+
+/*
+ * Angle-to-pulse lookup. Kept free of kernel dependencies so it can be
+ * compiled and exercised on the host.
+ *
+ * Angles are signed Q8 degrees (1/256 degree). The table holds
+ * SERVO_LUT_ENTRIES pulse widths evenly spaced over [min, max]; lookups
+ * scale the angle to a Q8 table position with one multiply and one shift
+ * and interpolate linearly between the two neighbouring entries.
+ */
+
+#include <stdint.h>
+
+#define SERVO_LUT_SEGMENTS 64
+#define SERVO_LUT_ENTRIES  65
+
+#define SERVO_ANGLE_Q8(deg) ((int32_t)(deg) * 256)
+
+struct servo_lut {
+	/** Lowest and highest angle, Q8 degrees. */
+	int32_t min_q8;
+	int32_t max_q8;
+	/** SERVO_LUT_SEGMENTS * 2^16 / range in degrees, rounded up. */
+	uint32_t scale;
+	/** Pulse widths in nanoseconds. */
+	uint32_t pulse[SERVO_LUT_ENTRIES];
+};
+
+/** Table scale for an angle range of @p range_deg degrees. */
+#define SERVO_LUT_SCALE(range_deg)                                                                 \
+	((uint32_t)((((uint64_t)SERVO_LUT_SEGMENTS << 16) + (range_deg) - 1) / (range_deg)))
+
+/* Nearest integer to n / d for d > 0, rounding halves away from zero. */
+#define SERVO_LUT_DIV_ROUND(n, d) (((n) < 0 ? (n) - (d) / 2 : (n) + (d) / 2) / (d))
+
+/**
+ * Linear interpolation through (a0, p0) and (a1, p1), evaluated at a and
+ * rounded to the nearest nanosecond for rising and falling pulses alike.
+ */
+#define SERVO_LUT_LERP(a0, p0, a1, p1, a)                                                          \
+	((uint32_t)((int64_t)(p0) +                                                                \
+		    SERVO_LUT_DIV_ROUND(((int64_t)(p1) - (int64_t)(p0)) *                          \
+						((int64_t)(a) - (int64_t)(a0)),                    \
+					((int64_t)(a1) - (int64_t)(a0)))))
+
+static inline uint32_t servo_lut_pulse(const struct servo_lut *lut, int32_t angle_q8)
+{
+	uint32_t pos;
+	uint32_t idx;
+	uint32_t frac;
+	int32_t lo;
+	int32_t hi;
+
+	if (angle_q8 <= lut->min_q8) {
+		return lut->pulse[0];
+	}
+
+	if (angle_q8 >= lut->max_q8) {
+		return lut->pulse[SERVO_LUT_SEGMENTS];
+	}
+
+	/* Q8 table position: offset in Q8 degrees * scale >> 16. */
+	pos = (uint32_t)(((uint64_t)(angle_q8 - lut->min_q8) * lut->scale) >> 16);
+	idx = pos >> 8;
+	frac = pos & 0xff;
+
+	if (idx >= SERVO_LUT_SEGMENTS) {
+		return lut->pulse[SERVO_LUT_SEGMENTS];
+	}
+
+	lo = (int32_t)lut->pulse[idx];
+	hi = (int32_t)lut->pulse[idx + 1];
+
+	return (uint32_t)(lo + (((hi - lo) * (int32_t)frac) >> 8));
+}
+
+#endif /* SERVO_LUT_H_ */
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Stack budget self-check. A timer interrupt posts servo and group commands
+ * the way the button ISR does, so the motor loop runs its deepest path
+ * (PWM update, motion planning, logging) while the system workqueue steps
+ * the single servo's moves. Once the hold timeout has parked the servos from
+ * the system workqueue, every thread's peak stack use is printed and
+ * compared with the margin. The report goes through printk so it also shows
+ * with the minimal logging of overlay-lean.conf.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+
+#include "motor.h"
+
+/* Let main() finish init before the first command. */
+#define START_MS 500
+/* Longer than a debounce window and a PWM period, like paced presses. */
+#define POST_MS  30
+#define POSTS    40
+
+/*
+ * After the last command: a full-range group move takes under 3 s at the
+ * default motion limits, and the group's hold timeout starts when it ends.
+ */
+#if defined(CONFIG_APP_SERVO_HOLD_TIMEOUT_MS)
+#define PARK_MS (3000 + CONFIG_APP_SERVO_HOLD_TIMEOUT_MS + 500)
+#else
+#define PARK_MS 3000
+#endif
+
+static uint32_t posted;
+static bool within_budget = true;
+
+static void check_thread(const struct k_thread *thread, void *user_data)
+{
+	size_t size = thread->stack_info.size;
+	size_t unused;
+	const char *name = k_thread_name_get((k_tid_t)thread);
+
+	ARG_UNUSED(user_data);
+
+	if (k_thread_stack_space_get(thread, &unused)) {
+		printk("%-12s stack not measurable\n", name);
+		return;
+	}
+
+	printk("%-12s %4zu of %4zu bytes used, %3zu%% unused\n", name, size - unused, size,
+	       unused * 100 / size);
+
+	if (unused * 100 < size * CONFIG_APP_STACK_CHECK_MARGIN_PCT) {
+		within_budget = false;
+	}
+}
+
+static void check(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	/* This runs on the system workqueue, so its own use is included. */
+	k_thread_foreach_unlocked(check_thread, NULL);
+
+	printk("Stack budgets %s (%u commands, margin %d%%)\n",
+	       within_budget ? "OK" : "exceeded", posted, CONFIG_APP_STACK_CHECK_MARGIN_PCT);
+}
+
+static K_WORK_DELAYABLE_DEFINE(check_work, check);
+
+static void post(struct k_timer *timer)
+{
+	enum motor_target target = (posted & 1) ? MOTOR_GROUP : MOTOR_SERVO;
+	int32_t deg = (posted & 2) ? 180 : 0;
+
+	(void)motor_post(target, deg, k_cycle_get_32());
+
+	if (++posted == POSTS) {
+		k_timer_stop(timer);
+		k_work_schedule(&check_work, K_MSEC(PARK_MS));
+	}
+}
+
+static K_TIMER_DEFINE(post_timer, post, NULL);
+
+static int stack_check_init(void)
+{
+	k_timer_start(&post_timer, K_MSEC(START_MS), K_MSEC(POST_MS));
+
+	return 0;
+}
+
+SYS_INIT(stack_check_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
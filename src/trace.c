@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#include "trace.h"
+
+#define SAMPLES     CONFIG_APP_TRACE_SAMPLES
+#define SAMPLE_MASK (SAMPLES - 1)
+#define BUCKETS     32
+
+BUILD_ASSERT(IS_POWER_OF_TWO(SAMPLES), "Trace sample count must be a power of two");
+
+/*
+ * Each stage is recorded from a single context (ISR or motor thread), so a
+ * stage ring has one writer. Readers take a best-effort snapshot; a sample
+ * written during the copy may show up either old or new.
+ */
+struct trace_ring {
+	uint32_t samples[SAMPLES];
+	atomic_t head;
+	atomic_t buckets[BUCKETS];
+};
+
+static struct trace_ring rings[TRACE_STAGE_COUNT];
+
+void trace_record(enum trace_stage stage, uint32_t edge_cyc)
+{
+	struct trace_ring *ring = &rings[stage];
+	uint32_t delta = k_cycle_get_32() - edge_cyc;
+	atomic_val_t h = atomic_get(&ring->head);
+
+	ring->samples[h & SAMPLE_MASK] = delta;
+	atomic_set(&ring->head, h + 1);
+	atomic_inc(&ring->buckets[delta == 0 ? 0 : 31 - __builtin_clz(delta)]);
+}
+
+int trace_summary_get(enum trace_stage stage, struct trace_summary *summary)
+{
+	static uint32_t sorted[SAMPLES];
+	struct trace_ring *ring = &rings[stage];
+	uint32_t count = atomic_get(&ring->head);
+	uint32_t n = MIN(count, SAMPLES);
+	uint64_t sum = 0;
+
+	if (n == 0) {
+		return -ENODATA;
+	}
+
+	memcpy(sorted, ring->samples, n * sizeof(sorted[0]));
+
+	/* Insertion sort; the ring is small and this runs from the shell. */
+	for (uint32_t i = 1; i < n; i++) {
+		uint32_t v = sorted[i];
+		uint32_t j = i;
+
+		while (j > 0 && sorted[j - 1] > v) {
+			sorted[j] = sorted[j - 1];
+			j--;
+		}
+		sorted[j] = v;
+	}
+
+	for (uint32_t i = 0; i < n; i++) {
+		sum += sorted[i];
+	}
+
+	summary->count = count;
+	summary->min_cyc = sorted[0];
+	summary->avg_cyc = (uint32_t)(sum / n);
+	summary->p99_cyc = sorted[(n * 99) / 100];
+	summary->max_cyc = sorted[n - 1];
+
+	return 0;
+}
+
+uint32_t trace_bucket_get(enum trace_stage stage, uint8_t bucket)
+{
+	if (bucket >= BUCKETS) {
+		return 0;
+	}
+
+	return atomic_get(&rings[stage].buckets[bucket]);
+}
+
+void trace_reset(void)
+{
+	for (size_t s = 0; s < TRACE_STAGE_COUNT; s++) {
+		atomic_set(&rings[s].head, 0);
+
+		for (size_t b = 0; b < BUCKETS; b++) {
+			atomic_set(&rings[s].buckets[b], 0);
+		}
+	}
+}
+
+#if defined(CONFIG_APP_TRACE_SHELL)
+static const char *const stage_names[TRACE_STAGE_COUNT] = {
+	[TRACE_STAGE_HANDLER] = "handler",
+	[TRACE_STAGE_DEQUEUE] = "dequeue",
+	[TRACE_STAGE_PWM_DONE] = "pwm_done",
+};
+
+static int cmd_trace_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct trace_summary summary;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%-9s %8s %8s %8s %8s %8s", "stage", "count", "min_us", "avg_us",
+		    "p99_us", "max_us");
+
+	for (size_t s = 0; s < TRACE_STAGE_COUNT; s++) {
+		if (trace_summary_get(s, &summary)) {
+			shell_print(sh, "%-9s %8u", stage_names[s], 0);
+			continue;
+		}
+
+		shell_print(sh, "%-9s %8u %8u %8u %8u %8u", stage_names[s], summary.count,
+			    k_cyc_to_us_floor32(summary.min_cyc),
+			    k_cyc_to_us_floor32(summary.avg_cyc),
+			    k_cyc_to_us_floor32(summary.p99_cyc),
+			    k_cyc_to_us_floor32(summary.max_cyc));
+	}
+
+	return 0;
+}
+
+static int cmd_trace_hist(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	for (size_t s = 0; s < TRACE_STAGE_COUNT; s++) {
+		shell_print(sh, "%s:", stage_names[s]);
+
+		for (uint8_t b = 0; b < BUCKETS; b++) {
+			uint32_t n = trace_bucket_get(s, b);
+
+			if (n == 0) {
+				continue;
+			}
+
+			shell_print(sh, "  < %10u us: %u",
+				    k_cyc_to_us_ceil32(b == BUCKETS - 1 ? UINT32_MAX : BIT(b + 1)),
+				    n);
+		}
+	}
+
+	return 0;
+}
+
+static int cmd_trace_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	trace_reset();
+	shell_print(sh, "Trace cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(trace_cmds,
+	SHELL_CMD(show, NULL, "Latency summary per stage", cmd_trace_show),
+	SHELL_CMD(hist, NULL, "Log2 latency histogram per stage", cmd_trace_hist),
+	SHELL_CMD(reset, NULL, "Clear all stages", cmd_trace_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(trace, &trace_cmds, "Button-to-PWM latency tracing", NULL);
+#endif /* CONFIG_APP_TRACE_SHELL */
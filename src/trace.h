@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <stdint.h>
+
+/*
+ * Hot-path latency tracepoints. Every stage records the cycles elapsed since
+ * the button edge that started the chain. With CONFIG_APP_TRACE disabled the
+ * TRACE_POINT() macro expands to nothing and its arguments are not evaluated.
+ */
+
+enum trace_stage {
+	/** button_handler() entered. */
+	TRACE_STAGE_HANDLER,
+	/** Motor thread took the command off the queue. */
+	TRACE_STAGE_DEQUEUE,
+	/** Servo PWM update returned. */
+	TRACE_STAGE_PWM_DONE,
+	TRACE_STAGE_COUNT,
+};
+
+/** Latency summary over the samples currently held for one stage. */
+struct trace_summary {
+	/** Samples recorded since the last reset. */
+	uint32_t count;
+	/** Statistics over the last CONFIG_APP_TRACE_SAMPLES samples, in cycles. */
+	uint32_t min_cyc;
+	uint32_t avg_cyc;
+	uint32_t p99_cyc;
+	uint32_t max_cyc;
+};
+
+#if defined(CONFIG_APP_TRACE)
+
+void trace_record(enum trace_stage stage, uint32_t edge_cyc);
+
+#define TRACE_POINT(stage, edge_cyc) trace_record(stage, edge_cyc)
+
+/** Summarise one stage. Returns -ENODATA when it holds no samples. */
+int trace_summary_get(enum trace_stage stage, struct trace_summary *summary);
+
+/** Number of samples in log2 bucket @p bucket (cycles in [2^b, 2^(b+1))). */
+uint32_t trace_bucket_get(enum trace_stage stage, uint8_t bucket);
+
+/** Clear all stages. Samples racing with the reset may survive it. */
+void trace_reset(void);
+
+#else
+
+#define TRACE_POINT(stage, edge_cyc)                                                               \
+	do {                                                                                       \
+	} while (false)
+
+#endif /* CONFIG_APP_TRACE */
+
+#endif /* TRACE_H_ */
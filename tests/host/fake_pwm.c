@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <nrfx_pwm.h>
+
+#include "fake_pwm.h"
+
+#define BUFFERS_MAX 16
+
+static struct {
+	const uint16_t *ptr;
+	size_t values;
+} buffers[BUFFERS_MAX];
+static size_t buffer_count;
+
+static nrfx_pwm_handler_t handler;
+static void *handler_context;
+
+void fake_pwm_buffer(const void *ptr, size_t values)
+{
+	if (buffer_count < BUFFERS_MAX) {
+		buffers[buffer_count].ptr = ptr;
+		buffers[buffer_count].values = values;
+		buffer_count++;
+	}
+}
+
+void fake_pwm_reset(void)
+{
+	buffer_count = 0;
+	handler = NULL;
+	handler_context = NULL;
+}
+
+/* Values readable from @p ptr, 0 when it is not inside a declared buffer. */
+static size_t room_at(const uint16_t *ptr)
+{
+	for (size_t i = 0; i < buffer_count; i++) {
+		if (ptr >= buffers[i].ptr && ptr < buffers[i].ptr + buffers[i].values) {
+			return buffers[i].values - (size_t)(ptr - buffers[i].ptr);
+		}
+	}
+
+	return 0;
+}
+
+static void check_seq(NRF_PWM_Type *reg, uint8_t seq_id)
+{
+	if (reg->seq_cnt[seq_id] > room_at(reg->seq_ptr[seq_id])) {
+		reg->violations++;
+	}
+}
+
+void nrf_pwm_seq_ptr_set(NRF_PWM_Type *p_reg, uint8_t seq_id, const uint16_t *p_values)
+{
+	p_reg->seq_ptr[seq_id] = p_values;
+	p_reg->reg_writes++;
+	check_seq(p_reg, seq_id);
+}
+
+void nrf_pwm_seq_cnt_set(NRF_PWM_Type *p_reg, uint8_t seq_id, uint16_t length)
+{
+	p_reg->seq_cnt[seq_id] = length;
+	p_reg->reg_writes++;
+	check_seq(p_reg, seq_id);
+}
+
+void nrf_pwm_int_enable(NRF_PWM_Type *p_reg, uint32_t mask)
+{
+	p_reg->inten |= mask;
+}
+
+void nrf_pwm_int_disable(NRF_PWM_Type *p_reg, uint32_t mask)
+{
+	p_reg->inten &= ~mask;
+}
+
+void nrf_pwm_event_clear(NRF_PWM_Type *p_reg, nrf_pwm_event_t event)
+{
+	p_reg->seqend[event == NRF_PWM_EVENT_SEQEND1] = false;
+}
+
+static void latch(NRF_PWM_Type *reg, uint8_t seq_id)
+{
+	reg->seq = seq_id;
+	reg->pos = 0;
+	reg->latched_ptr = reg->seq_ptr[seq_id];
+	reg->latched_cnt = reg->seq_cnt[seq_id];
+
+	if (reg->latched_cnt > room_at(reg->latched_ptr)) {
+		reg->violations++;
+		reg->latched_cnt = room_at(reg->latched_ptr);
+	}
+}
+
+nrfx_err_t nrfx_pwm_init(const nrfx_pwm_t *p_instance, const nrfx_pwm_config_t *p_config,
+			 nrfx_pwm_handler_t evt_handler, void *p_context)
+{
+	(void)p_config;
+
+	memset(p_instance->p_reg, 0, sizeof(*p_instance->p_reg));
+	handler = evt_handler;
+	handler_context = p_context;
+
+	return NRFX_SUCCESS;
+}
+
+uint32_t nrfx_pwm_simple_playback(const nrfx_pwm_t *p_instance,
+				  const nrf_pwm_sequence_t *p_sequence, uint16_t playback_count,
+				  uint32_t flags)
+{
+	NRF_PWM_Type *reg = p_instance->p_reg;
+
+	(void)playback_count;
+
+	/* Like nrfx: both sequences play the same buffer. */
+	for (uint8_t n = 0; n < 2; n++) {
+		reg->seq_ptr[n] = p_sequence->values.p_raw;
+		reg->seq_cnt[n] = p_sequence->length;
+	}
+
+	reg->inten = ((flags & NRFX_PWM_FLAG_SIGNAL_END_SEQ0) ? NRF_PWM_INT_SEQEND0_MASK : 0) |
+		     ((flags & NRFX_PWM_FLAG_SIGNAL_END_SEQ1) ? NRF_PWM_INT_SEQEND1_MASK : 0);
+	reg->playing = true;
+	latch(reg, 0);
+
+	return 0;
+}
+
+bool nrfx_pwm_stop(const nrfx_pwm_t *p_instance, bool wait_until_stopped)
+{
+	NRF_PWM_Type *reg = p_instance->p_reg;
+
+	(void)wait_until_stopped;
+
+	reg->playing = false;
+	memset(reg->out, 0, sizeof(reg->out));
+
+	return true;
+}
+
+bool nrfx_pwm_is_stopped(const nrfx_pwm_t *p_instance)
+{
+	return !p_instance->p_reg->playing;
+}
+
+void fake_pwm_run(NRF_PWM_Type *reg, uint32_t periods)
+{
+	for (uint32_t p = 0; p < periods; p++) {
+		reg->periods++;
+
+		if (!reg->playing || reg->latched_cnt < NRF_PWM_CHANNEL_COUNT) {
+			continue;
+		}
+
+		memcpy(reg->out, &reg->latched_ptr[reg->pos], sizeof(reg->out));
+		reg->pos += NRF_PWM_CHANNEL_COUNT;
+
+		if (reg->pos + NRF_PWM_CHANNEL_COUNT <= reg->latched_cnt) {
+			continue;
+		}
+
+		/* Last value applied: the other sequence latches and SEQEND fires. */
+		uint8_t ended = reg->seq;
+		uint32_t mask = ended ? NRF_PWM_INT_SEQEND1_MASK : NRF_PWM_INT_SEQEND0_MASK;
+
+		latch(reg, ended ^ 1);
+		reg->seqend[ended] = true;
+
+		if ((reg->inten & mask) && handler != NULL) {
+			reg->seqend[ended] = false;
+			reg->irqs++;
+			handler(ended ? NRFX_PWM_EVT_END_SEQ1 : NRFX_PWM_EVT_END_SEQ0,
+				handler_context);
+		}
+	}
+}
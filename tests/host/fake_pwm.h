@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef FAKE_PWM_H_
+#define FAKE_PWM_H_
+
+/*
+ * Period-accurate model of an nRF PWM instance in individual load mode.
+ *
+ * Each period applies the next four compare values of the playing sequence.
+ * When the last value of SEQ[n] is applied, SEQ[n ^ 1] latches its PTR and
+ * CNT, SEQEND[n] is raised and, if enabled, the nrfx handler runs before the
+ * next period. Looped playback alternates between the two sequences forever.
+ *
+ * EasyDMA reads are bounds-checked: every buffer the code under test hands
+ * to the peripheral must be declared with fake_pwm_buffer() first, and any
+ * register write or sequence start that leaves CNT past the end of the
+ * buffer at PTR counts as a violation.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <hal/nrf_pwm.h>
+
+/** Declare a buffer of @p values 16-bit compare values. */
+void fake_pwm_buffer(const void *ptr, size_t values);
+
+/** Forget every declared buffer and the registered nrfx handler. */
+void fake_pwm_reset(void);
+
+/** Play @p periods PWM periods, calling the nrfx handler on enabled SEQEND events. */
+void fake_pwm_run(NRF_PWM_Type *reg, uint32_t periods);
+
+#endif /* FAKE_PWM_H_ */
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+/*
+ * Minimal check helpers for the host tests. A failed check prints where and
+ * why and the test keeps going; HOST_TEST_EXIT() turns the failure count
+ * into the process exit status for CTest.
+ */
+
+#include <stdio.h>
+
+static int host_test_failures;
+
+#define CHECK(cond, ...)                                                                           \
+	do {                                                                                       \
+		if (!(cond)) {                                                                     \
+			host_test_failures++;                                                      \
+			fprintf(stderr, "%s:%d: %s: ", __FILE__, __LINE__, #cond);                 \
+			fprintf(stderr, __VA_ARGS__);                                              \
+			fputc('\n', stderr);                                                       \
+		}                                                                                  \
+	} while (0)
+
+#define HOST_TEST_EXIT()                                                                           \
+	do {                                                                                       \
+		printf("%s\n", host_test_failures ? "FAIL" : "PASS");                              \
+		return host_test_failures ? 1 : 0;                                                 \
+	} while (0)
+
+#endif /* HOST_TEST_H_ */
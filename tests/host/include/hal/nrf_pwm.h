@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Host stand-in for the nrfx PWM HAL. NRF_PWM_Type is a fake peripheral
+ * driven by fake_pwm_run(); the register accessors are implemented in
+ * fake_pwm.c, which checks every write.
+ */
+
+#ifndef HOST_HAL_NRF_PWM_H_
+#define HOST_HAL_NRF_PWM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define NRF_PWM_CHANNEL_COUNT     4
+#define NRF_PWM_PIN_NOT_CONNECTED 0xFFFFFFFFU
+
+#define NRF_PWM_VALUES_LENGTH(array) (sizeof(array) / sizeof(uint16_t))
+
+#define NRF_PWM_INT_SEQEND0_MASK (1U << 4)
+#define NRF_PWM_INT_SEQEND1_MASK (1U << 5)
+
+typedef enum {
+	NRF_PWM_EVENT_SEQEND0,
+	NRF_PWM_EVENT_SEQEND1,
+} nrf_pwm_event_t;
+
+typedef enum {
+	NRF_PWM_CLK_1MHz = 4,
+} nrf_pwm_clk_t;
+
+typedef enum {
+	NRF_PWM_MODE_UP,
+} nrf_pwm_mode_t;
+
+typedef enum {
+	NRF_PWM_LOAD_INDIVIDUAL = 2,
+} nrf_pwm_dec_load_t;
+
+typedef enum {
+	NRF_PWM_STEP_AUTO,
+} nrf_pwm_dec_step_t;
+
+typedef struct {
+	uint16_t channel_0;
+	uint16_t channel_1;
+	uint16_t channel_2;
+	uint16_t channel_3;
+} nrf_pwm_values_individual_t;
+
+typedef struct {
+	union {
+		const uint16_t *p_raw;
+		const nrf_pwm_values_individual_t *p_individual;
+	} values;
+	uint16_t length;
+	uint32_t repeats;
+	uint32_t end_delay;
+} nrf_pwm_sequence_t;
+
+typedef struct {
+	/* Registers. */
+	const uint16_t *seq_ptr[2];
+	uint32_t seq_cnt[2];
+	uint32_t inten;
+	bool seqend[2];
+
+	/* Playback state. */
+	bool playing;
+	uint8_t seq;
+	uint32_t pos;
+	const uint16_t *latched_ptr;
+	uint32_t latched_cnt;
+	/* Compare values applied in the last period, 0 while stopped. */
+	uint16_t out[NRF_PWM_CHANNEL_COUNT];
+
+	/* Observations. */
+	uint32_t periods;
+	uint32_t reg_writes;
+	uint32_t irqs;
+	/* Writes or sequence starts that left CNT past the end of PTR. */
+	uint32_t violations;
+} NRF_PWM_Type;
+
+void nrf_pwm_seq_ptr_set(NRF_PWM_Type *p_reg, uint8_t seq_id, const uint16_t *p_values);
+void nrf_pwm_seq_cnt_set(NRF_PWM_Type *p_reg, uint8_t seq_id, uint16_t length);
+void nrf_pwm_int_enable(NRF_PWM_Type *p_reg, uint32_t mask);
+void nrf_pwm_int_disable(NRF_PWM_Type *p_reg, uint32_t mask);
+void nrf_pwm_event_clear(NRF_PWM_Type *p_reg, nrf_pwm_event_t event);
+
+#endif /* HOST_HAL_NRF_PWM_H_ */
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Host stand-in for the nrfx PWM driver, on top of the fake peripheral. */
+
+#ifndef HOST_NRFX_PWM_H_
+#define HOST_NRFX_PWM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <hal/nrf_pwm.h>
+
+typedef int nrfx_err_t;
+
+#define NRFX_SUCCESS 0x0BAD0000
+
+typedef struct {
+	NRF_PWM_Type *p_reg;
+} nrfx_pwm_t;
+
+typedef enum {
+	NRFX_PWM_EVT_FINISHED,
+	NRFX_PWM_EVT_END_SEQ0,
+	NRFX_PWM_EVT_END_SEQ1,
+	NRFX_PWM_EVT_STOPPED,
+} nrfx_pwm_evt_type_t;
+
+typedef void (*nrfx_pwm_handler_t)(nrfx_pwm_evt_type_t event_type, void *p_context);
+
+enum {
+	NRFX_PWM_FLAG_STOP = 0x01,
+	NRFX_PWM_FLAG_LOOP = 0x02,
+	NRFX_PWM_FLAG_SIGNAL_END_SEQ0 = 0x04,
+	NRFX_PWM_FLAG_SIGNAL_END_SEQ1 = 0x08,
+	NRFX_PWM_FLAG_NO_EVT_FINISHED = 0x10,
+};
+
+typedef struct {
+	uint32_t output_pins[NRF_PWM_CHANNEL_COUNT];
+	uint8_t irq_priority;
+	nrf_pwm_clk_t base_clock;
+	nrf_pwm_mode_t count_mode;
+	uint16_t top_value;
+	nrf_pwm_dec_load_t load_mode;
+	nrf_pwm_dec_step_t step_mode;
+	bool skip_gpio_cfg;
+	bool skip_psel_cfg;
+} nrfx_pwm_config_t;
+
+nrfx_err_t nrfx_pwm_init(const nrfx_pwm_t *p_instance, const nrfx_pwm_config_t *p_config,
+			 nrfx_pwm_handler_t handler, void *p_context);
+
+uint32_t nrfx_pwm_simple_playback(const nrfx_pwm_t *p_instance,
+				  const nrf_pwm_sequence_t *p_sequence, uint16_t playback_count,
+				  uint32_t flags);
+
+bool nrfx_pwm_stop(const nrfx_pwm_t *p_instance, bool wait_until_stopped);
+
+bool nrfx_pwm_is_stopped(const nrfx_pwm_t *p_instance);
+
+#endif /* HOST_NRFX_PWM_H_ */
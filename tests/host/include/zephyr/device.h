@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef HOST_ZEPHYR_DEVICE_H_
+#define HOST_ZEPHYR_DEVICE_H_
+
+struct pm_device;
+
+struct device {
+	const char *name;
+	const void *config;
+	void *data;
+	/* Only set by tests that exercise runtime PM. */
+	struct pm_device *pm;
+};
+
+#endif /* HOST_ZEPHYR_DEVICE_H_ */
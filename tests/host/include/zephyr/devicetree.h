@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Host builds have no devicetree: instance macros expand to nothing and the
+ * tests build their own config structures.
+ */
+
+#ifndef HOST_ZEPHYR_DEVICETREE_H_
+#define HOST_ZEPHYR_DEVICETREE_H_
+
+#define DT_INST_FOREACH_STATUS_OKAY(fn)
+
+#endif /* HOST_ZEPHYR_DEVICETREE_H_ */
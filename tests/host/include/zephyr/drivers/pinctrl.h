@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Host stand-in for <zephyr/drivers/pinctrl.h> that remembers the last state. */
+
+#ifndef HOST_ZEPHYR_DRIVERS_PINCTRL_H_
+#define HOST_ZEPHYR_DRIVERS_PINCTRL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PINCTRL_STATE_DEFAULT 0U
+#define PINCTRL_STATE_SLEEP   1U
+
+struct pinctrl_dev_config {
+	uint8_t state;
+};
+
+static inline int pinctrl_apply_state(const struct pinctrl_dev_config *config, uint8_t id)
+{
+	if (config != NULL) {
+		((struct pinctrl_dev_config *)config)->state = id;
+	}
+
+	return 0;
+}
+
+#endif /* HOST_ZEPHYR_DRIVERS_PINCTRL_H_ */
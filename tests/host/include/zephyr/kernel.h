@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Host stand-in for <zephyr/kernel.h>: single-threaded, so locks are no-ops. */
+
+#ifndef HOST_ZEPHYR_KERNEL_H_
+#define HOST_ZEPHYR_KERNEL_H_
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+
+#define NSEC_PER_USEC 1000U
+#define NSEC_PER_MSEC 1000000U
+
+struct k_spinlock {
+	int locked;
+};
+
+typedef int k_spinlock_key_t;
+
+typedef struct {
+	int64_t ms;
+} k_timeout_t;
+
+#define K_MSEC(ms) ((k_timeout_t){(ms)})
+#define K_FOREVER  ((k_timeout_t){-1})
+
+struct k_mutex {
+	int locked;
+};
+
+static inline void k_mutex_init(struct k_mutex *mutex)
+{
+	mutex->locked = 0;
+}
+
+static inline int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+	ARG_UNUSED(timeout);
+	mutex->locked++;
+	return 0;
+}
+
+static inline int k_mutex_unlock(struct k_mutex *mutex)
+{
+	mutex->locked--;
+	return 0;
+}
+
+/*
+ * Delayable work never runs by itself: a test fires a scheduled item with
+ * host_work_expire(), standing in for the timeout.
+ */
+struct k_work;
+typedef void (*k_work_handler_t)(struct k_work *work);
+
+struct k_work {
+	k_work_handler_t handler;
+};
+
+struct k_work_delayable {
+	struct k_work work;
+	bool pending;
+	k_timeout_t timeout;
+};
+
+static inline void k_work_init_delayable(struct k_work_delayable *dwork, k_work_handler_t handler)
+{
+	dwork->work.handler = handler;
+	dwork->pending = false;
+}
+
+static inline struct k_work_delayable *k_work_delayable_from_work(struct k_work *work)
+{
+	return CONTAINER_OF(work, struct k_work_delayable, work);
+}
+
+static inline int k_work_reschedule(struct k_work_delayable *dwork, k_timeout_t delay)
+{
+	dwork->pending = true;
+	dwork->timeout = delay;
+	return 1;
+}
+
+static inline bool k_work_delayable_is_pending(const struct k_work_delayable *dwork)
+{
+	return dwork->pending;
+}
+
+/* Run @p dwork now if it is scheduled; returns whether it ran. */
+static inline bool host_work_expire(struct k_work_delayable *dwork)
+{
+	if (!dwork->pending) {
+		return false;
+	}
+
+	dwork->pending = false;
+	dwork->work.handler(&dwork->work);
+	return true;
+}
+
+/* Provided by the tests that need a clock. */
+uint32_t k_cycle_get_32(void);
+
+static inline k_spinlock_key_t k_spin_lock(struct k_spinlock *lock)
+{
+	lock->locked++;
+	return 0;
+}
+
+static inline void k_spin_unlock(struct k_spinlock *lock, k_spinlock_key_t key)
+{
+	ARG_UNUSED(key);
+	lock->locked--;
+}
+
+#endif /* HOST_ZEPHYR_KERNEL_H_ */
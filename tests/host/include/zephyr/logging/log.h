@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef HOST_ZEPHYR_LOGGING_LOG_H_
+#define HOST_ZEPHYR_LOGGING_LOG_H_
+
+#include <stdio.h>
+
+#define LOG_LEVEL_ERR 1
+#define LOG_LEVEL_WRN 2
+#define LOG_LEVEL_INF 3
+#define LOG_LEVEL_DBG 4
+
+#define LOG_MODULE_REGISTER(name, ...) static const char log_module_name[] __attribute__((unused)) = #name
+
+#define LOG_ERR(fmt, ...) fprintf(stderr, "%s: " fmt "\n", log_module_name, ##__VA_ARGS__)
+#define LOG_WRN(fmt, ...) fprintf(stderr, "%s: " fmt "\n", log_module_name, ##__VA_ARGS__)
+#define LOG_INF(fmt, ...) (void)0
+#define LOG_DBG(fmt, ...) (void)0
+
+#endif /* HOST_ZEPHYR_LOGGING_LOG_H_ */
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Host stand-in for <zephyr/pm/device.h>. Tests hook a struct pm_device
+ * holding the driver's action callback onto their struct device.
+ */
+
+#ifndef HOST_ZEPHYR_PM_DEVICE_H_
+#define HOST_ZEPHYR_PM_DEVICE_H_
+
+#include <stdbool.h>
+
+#include <zephyr/device.h>
+
+enum pm_device_action {
+	PM_DEVICE_ACTION_SUSPEND,
+	PM_DEVICE_ACTION_RESUME,
+};
+
+struct pm_device {
+	int (*action)(const struct device *dev, enum pm_device_action action);
+	bool enabled;
+	bool suspended;
+	int usage;
+};
+
+static inline void pm_device_init_suspended(const struct device *dev)
+{
+	if (dev->pm != NULL) {
+		dev->pm->suspended = true;
+	}
+}
+
+#endif /* HOST_ZEPHYR_PM_DEVICE_H_ */
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Host stand-in for <zephyr/pm/device_runtime.h>: synchronous, usage counted. */
+
+#ifndef HOST_ZEPHYR_PM_DEVICE_RUNTIME_H_
+#define HOST_ZEPHYR_PM_DEVICE_RUNTIME_H_
+
+#include <errno.h>
+
+#include <zephyr/pm/device.h>
+
+static inline int pm_device_runtime_enable(const struct device *dev)
+{
+	if (dev->pm != NULL) {
+		dev->pm->enabled = true;
+	}
+
+	return 0;
+}
+
+static inline int pm_device_runtime_get(const struct device *dev)
+{
+	struct pm_device *pm = dev->pm;
+	int err;
+
+	if (pm == NULL || !pm->enabled) {
+		return 0;
+	}
+
+	if (pm->usage++ == 0 && pm->suspended) {
+		err = pm->action(dev, PM_DEVICE_ACTION_RESUME);
+		if (err) {
+			pm->usage--;
+			return err;
+		}
+		pm->suspended = false;
+	}
+
+	return 0;
+}
+
+static inline int pm_device_runtime_put(const struct device *dev)
+{
+	struct pm_device *pm = dev->pm;
+	int err;
+
+	if (pm == NULL || !pm->enabled) {
+		return 0;
+	}
+
+	if (pm->usage == 0) {
+		return -EALREADY;
+	}
+
+	if (--pm->usage == 0) {
+		err = pm->action(dev, PM_DEVICE_ACTION_SUSPEND);
+		if (err) {
+			pm->usage++;
+			return err;
+		}
+		pm->suspended = true;
+	}
+
+	return 0;
+}
+
+#endif /* HOST_ZEPHYR_PM_DEVICE_RUNTIME_H_ */
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Host stand-in for <zephyr/shell/shell.h>: shell commands are not built. */
+
+#ifndef HOST_ZEPHYR_SHELL_SHELL_H_
+#define HOST_ZEPHYR_SHELL_SHELL_H_
+
+#endif /* HOST_ZEPHYR_SHELL_SHELL_H_ */
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Host stand-in for <zephyr/sys/atomic.h>, on the same compiler builtins as
+ * CONFIG_ATOMIC_OPERATIONS_BUILTIN.
+ */
+
+#ifndef HOST_ZEPHYR_SYS_ATOMIC_H_
+#define HOST_ZEPHYR_SYS_ATOMIC_H_
+
+typedef long atomic_t;
+typedef atomic_t atomic_val_t;
+
+static inline atomic_val_t atomic_get(const atomic_t *target)
+{
+	return __atomic_load_n(target, __ATOMIC_SEQ_CST);
+}
+
+static inline atomic_val_t atomic_set(atomic_t *target, atomic_val_t value)
+{
+	return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST);
+}
+
+static inline atomic_val_t atomic_inc(atomic_t *target)
+{
+	return __atomic_fetch_add(target, 1, __ATOMIC_SEQ_CST);
+}
+
+#endif /* HOST_ZEPHYR_SYS_ATOMIC_H_ */
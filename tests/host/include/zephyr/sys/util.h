@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Host stand-in for the subset of <zephyr/sys/util.h> the sources use. */
+
+#ifndef HOST_ZEPHYR_SYS_UTIL_H_
+#define HOST_ZEPHYR_SYS_UTIL_H_
+
+#include <stddef.h>
+
+#define BIT(n)          (1UL << (n))
+#define ARRAY_SIZE(a)   (sizeof(a) / sizeof((a)[0]))
+#define MAX(a, b)       (((a) > (b)) ? (a) : (b))
+#define MIN(a, b)       (((a) < (b)) ? (a) : (b))
+#define ARG_UNUSED(x)   (void)(x)
+#define CONTAINER_OF(ptr, type, field) ((type *)(((char *)(ptr)) - offsetof(type, field)))
+#define IS_POWER_OF_TWO(x) (((x) != 0U) && (((x) & ((x) - 1U)) == 0U))
+#define BUILD_ASSERT(cond, msg) _Static_assert(cond, msg)
+
+/* Same trick as Zephyr: 1 when the macro is defined to 1, else 0. */
+#define Z_IS_ENABLED_XXXX1                    _YYYY,
+#define Z_IS_ENABLED3(ignore_this, val, ...) val
+#define Z_IS_ENABLED2(one_or_two_args)       Z_IS_ENABLED3(one_or_two_args 1, 0)
+#define Z_IS_ENABLED1(config_macro)          Z_IS_ENABLED2(Z_IS_ENABLED_XXXX##config_macro)
+#define IS_ENABLED(config_macro)             Z_IS_ENABLED1(config_macro)
+
+#endif /* HOST_ZEPHYR_SYS_UTIL_H_ */
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Shape checks for every planned profile (starts at 0, ends exactly on
+ * the target, never moves backwards, honours the speed and acceleration
+ * limits), followed by a benchmark of what generating the samples costs
+ * and how much playback buffer a second of motion needs.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "host_test.h"
+#include "motion_profile.h"
+
+#define PERIOD_US     20000
+#define SEG_PERIODS   10
+/* One nrf_pwm_values_individual_t per period. */
+#define BYTES_PER_PERIOD 8
+/* Start of every checked move, Q8 degrees. */
+#define FROM_Q8 (256 * 45)
+
+struct limit_case {
+	uint32_t speed_dps;
+	uint32_t accel_dps2;
+};
+
+static const struct limit_case limit_cases[] = {
+	{180, 720},   /* Kconfig defaults */
+	{60, 120},    /* slow and gentle */
+	{600, 10000}, /* fast hobby servo */
+	{1, 1},       /* degenerate */
+};
+
+static const int32_t distances_q8[] = {
+	0, 1, 127, 256, 256 * 10, 256 * 90, -256 * 90, 256 * 180, 256 * 360,
+};
+
+static const char *const shape_names[] = {
+	[MOTION_TRAPEZOID] = "trapezoid",
+	[MOTION_SCURVE] = "s-curve",
+};
+
+/*
+ * Progress is Q16 of the distance, so positions are quantised to
+ * 1/65536 of the move; on long, slow moves that step is a sizeable part
+ * of the per-step acceleration. Each difference taken may be off by one
+ * such quantum plus a Q16 degree of rounding.
+ */
+static void check_profile(enum motion_shape shape, const struct limit_case *lc, int32_t dist_q8)
+{
+	struct motion_limits limits;
+	struct motion_profile profile;
+	uint64_t dist = (uint64_t)(dist_q8 < 0 ? -(int64_t)dist_q8 : dist_q8) << 8;
+	int32_t from = FROM_Q8;
+	int32_t to = from + dist_q8;
+	uint64_t prev_pos = 0;
+	int64_t prev_vel = 0;
+	double worst_vel = 0.0;
+	double worst_acc = 0.0;
+	int64_t quantum = (int64_t)(dist >> 16) + 1;
+
+	motion_limits_from_rate(&limits, lc->speed_dps, lc->accel_dps2, PERIOD_US);
+	motion_profile_plan(&profile, shape, dist_q8, &limits);
+
+	CHECK(profile.steps >= 1, "%s %d: empty profile", shape_names[shape], dist_q8);
+	CHECK(motion_profile_progress(&profile, 0) == 0 || profile.steps == 1,
+	      "%s %d: does not start at 0", shape_names[shape], dist_q8);
+	CHECK(motion_profile_progress(&profile, profile.steps) == MOTION_PROGRESS_ONE,
+	      "%s %d: does not end at 1", shape_names[shape], dist_q8);
+	CHECK(motion_profile_progress(&profile, profile.steps + 100) == MOTION_PROGRESS_ONE,
+	      "%s %d: not clamped past the end", shape_names[shape], dist_q8);
+	CHECK(motion_profile_lerp(from, to, motion_profile_progress(&profile, profile.steps)) == to,
+	      "%s %d: misses the target", shape_names[shape], dist_q8);
+
+	for (uint32_t k = 1; k <= profile.steps; k++) {
+		uint32_t p = motion_profile_progress(&profile, k);
+		uint32_t p_prev = motion_profile_progress(&profile, k - 1);
+		uint64_t pos = (dist * p) >> 16;
+		int64_t vel = (int64_t)(pos - prev_pos);
+		int64_t acc = vel - prev_vel;
+
+		CHECK(p >= p_prev, "%s %d: step %u goes backwards", shape_names[shape], dist_q8, k);
+
+		/* The last step may also absorb the remainder of the rounding. */
+		if (k < profile.steps) {
+			CHECK(vel <= (int64_t)limits.vel_q16 + quantum,
+			      "%s %d: step %u travels %lld, limit %u", shape_names[shape], dist_q8, k,
+			      (long long)vel, limits.vel_q16);
+			CHECK(acc <= (int64_t)limits.acc_q16 + 2 * quantum &&
+				      -acc <= (int64_t)limits.acc_q16 + 2 * quantum,
+			      "%s %d: step %u accelerates %lld, limit %u", shape_names[shape],
+			      dist_q8, k, (long long)acc, limits.acc_q16);
+			worst_vel = fmax(worst_vel, (double)vel / limits.vel_q16);
+			worst_acc = fmax(worst_acc, (double)(acc < 0 ? -acc : acc) / limits.acc_q16);
+		}
+
+		prev_pos = pos;
+		prev_vel = vel;
+	}
+
+	if (lc == &limit_cases[0] && dist_q8 == 256 * 180) {
+		printf("%-9s 180 deg at %u deg/s, %u deg/s^2: %u steps (%.2f s), "
+		       "peak %.0f%% of speed, %.0f%% of accel limit\n",
+		       shape_names[shape], lc->speed_dps, lc->accel_dps2, profile.steps,
+		       profile.steps * (PERIOD_US / 1e6), 100 * worst_vel, 100 * worst_acc);
+	}
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000U + ts.tv_nsec;
+}
+
+/*
+ * What servo_group.c does per segment interrupt: one progress sample per
+ * period and one interpolation per servo. Reported per step and per
+ * second of motion, next to the playback memory: two fixed segments
+ * versus a table holding the whole move.
+ */
+static void bench(enum motion_shape shape)
+{
+	struct motion_limits limits;
+	struct motion_profile profile;
+	volatile int32_t sink = 0;
+	uint64_t steps = 0;
+	uint64_t start;
+	uint64_t plan_ns;
+	uint64_t step_ns;
+	const int rounds = 2000;
+	uint32_t per_second = 1000000U / PERIOD_US;
+
+	motion_limits_from_rate(&limits, 180, 720, PERIOD_US);
+
+	start = now_ns();
+	for (int r = 0; r < rounds; r++) {
+		motion_profile_plan(&profile, shape, 256 * (1 + r % 180), &limits);
+		sink += profile.steps;
+	}
+	plan_ns = now_ns() - start;
+
+	start = now_ns();
+	for (int r = 0; r < rounds; r++) {
+		motion_profile_plan(&profile, shape, 256 * (1 + r % 180), &limits);
+		for (uint32_t k = 1; k <= profile.steps; k++) {
+			uint32_t p = motion_profile_progress(&profile, k);
+
+			for (int i = 0; i < 4; i++) {
+				sink += motion_profile_lerp(0, 256 * (1 + r % 180), p);
+			}
+		}
+		steps += profile.steps;
+	}
+	step_ns = now_ns() - start - plan_ns;
+
+	printf("%-9s plan %.0f ns, %.1f ns per step of 4 servos, %.1f us CPU per second of "
+	       "motion (host)\n",
+	       shape_names[shape], (double)plan_ns / rounds, (double)step_ns / steps,
+	       (double)step_ns / steps * per_second / 1000.0);
+	printf("%-9s playback memory: %u B fixed in segments vs %u B per second for a "
+	       "whole-move table; %u interrupts per second of motion\n",
+	       shape_names[shape], 2 * SEG_PERIODS * BYTES_PER_PERIOD,
+	       per_second * BYTES_PER_PERIOD, per_second / SEG_PERIODS);
+}
+
+int main(void)
+{
+	for (int shape = MOTION_TRAPEZOID; shape <= MOTION_SCURVE; shape++) {
+		for (size_t l = 0; l < sizeof(limit_cases) / sizeof(limit_cases[0]); l++) {
+			for (size_t d = 0; d < sizeof(distances_q8) / sizeof(distances_q8[0]); d++) {
+				check_profile(shape, &limit_cases[l], distances_q8[d]);
+			}
+		}
+	}
+
+	bench(MOTION_TRAPEZOID);
+	bench(MOTION_SCURVE);
+
+	HOST_TEST_EXIT();
+}
@@ -0,0 +1,510 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * servo_group.c against a fake nRF PWM: buffer and pointer sequencing,
+ * register write counts, with CONFIG_APP_SERVO_MOTION segment playback
+ * and with CONFIG_APP_SERVO_GROUP_PM parking after the hold timeout. The driver is included directly so the test can build its own
+ * instance without devicetree.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host_test.h"
+#include "fake_pwm.h"
+
+#include "servo_group.c"
+
+#define SERVOS     NRF_PWM_CHANNEL_COUNT
+#define PERIOD_US  20000
+#define MIN_PULSE  1000000
+#define MAX_PULSE  2000000
+/* Long enough for any move in these tests to finish. */
+#define SETTLE_PERIODS 200
+
+static NRF_PWM_Type pwm_reg;
+static struct pinctrl_dev_config pcfg;
+static struct servo_lut luts[SERVOS];
+/* Reversed channel order, so devicetree order and PWM channel differ. */
+static const uint8_t channels[SERVOS] = {3, 2, 1, 0};
+
+static void irq_connect(void)
+{
+}
+
+static const struct servo_group_config config = {
+	.pwm = {.p_reg = &pwm_reg},
+	.irq_connect = irq_connect,
+	.pcfg = &pcfg,
+	.top = PERIOD_US,
+	.count = SERVOS,
+	.channels = channels,
+	.luts = luts,
+};
+
+static struct servo_group_data data;
+
+#if defined(CONFIG_APP_SERVO_GROUP_PM)
+static struct pm_device pm;
+#endif
+
+static const struct device dev = {
+	.name = "servo_group",
+	.config = &config,
+	.data = &data,
+#if defined(CONFIG_APP_SERVO_GROUP_PM)
+	.pm = &pm,
+#endif
+};
+
+static uint16_t compare_at(int32_t deg)
+{
+	return to_compare(&luts[0], SERVO_ANGLE_Q8(deg));
+}
+
+/* Fresh peripheral and driver instance; every servo maps 0-180 to 1-2 ms. */
+static void setup(void)
+{
+	for (int i = 0; i < SERVOS; i++) {
+		luts[i].min_q8 = SERVO_ANGLE_Q8(0);
+		luts[i].max_q8 = SERVO_ANGLE_Q8(180);
+		luts[i].scale = SERVO_LUT_SCALE(180);
+		for (int k = 0; k < SERVO_LUT_ENTRIES; k++) {
+			luts[i].pulse[k] = SERVO_LUT_LERP(0, MIN_PULSE, SERVO_LUT_SEGMENTS, MAX_PULSE, k);
+		}
+	}
+
+	memset(&data, 0, sizeof(data));
+#if defined(CONFIG_APP_SERVO_GROUP_PM)
+	memset(&pm, 0, sizeof(pm));
+	pm.action = servo_group_pm_action;
+#endif
+	fake_pwm_reset();
+	fake_pwm_buffer(data.values, ARRAY_SIZE(data.values) * NRF_PWM_CHANNEL_COUNT);
+#if defined(CONFIG_APP_SERVO_MOTION)
+	fake_pwm_buffer(data.seg[0], SEG_PERIODS * NRF_PWM_CHANNEL_COUNT);
+	fake_pwm_buffer(data.seg[1], SEG_PERIODS * NRF_PWM_CHANNEL_COUNT);
+#endif
+
+	CHECK(servo_group_init(&dev) == 0, "init failed");
+	CHECK(pcfg.state == (IS_ENABLED(CONFIG_APP_SERVO_GROUP_PM) ? PINCTRL_STATE_SLEEP
+								   : PINCTRL_STATE_DEFAULT),
+	      "pins in state %u after init", pcfg.state);
+}
+
+/* Output of servo @p i (devicetree order) in the last period. */
+static uint16_t output(int i)
+{
+	return pwm_reg.out[channels[i]];
+}
+
+static bool outputs_equal(const uint16_t *expect)
+{
+	for (int i = 0; i < SERVOS; i++) {
+		if (output(i) != expect[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void test_first_update_starts_playback(void)
+{
+	struct servo_group_stats stats;
+
+	setup();
+
+	CHECK(servo_group_set_all(&dev, 90) == 0, "set_all failed");
+	servo_group_stats_get(&dev, &stats);
+	CHECK(stats.starts == 1 && stats.updates == 1, "%u starts, %u updates", stats.starts,
+	      stats.updates);
+	CHECK(stats.reg_writes == 0, "a fresh start wrote %u registers", stats.reg_writes);
+
+	fake_pwm_run(&pwm_reg, 1);
+	for (int i = 0; i < SERVOS; i++) {
+		CHECK(output(i) == compare_at(90), "servo %d at 0x%04x", i, output(i));
+	}
+}
+
+/*
+ * A running group swaps both sequence pointers and nothing else. All four
+ * channels must change together in one period, within two periods of the
+ * call, and never show a mix of old and new values.
+ */
+static void test_update_lands_in_one_period(void)
+{
+	static const int32_t angles[SERVOS] = {0, 45, 135, 180};
+	int32_t angle_q8[SERVOS];
+	uint16_t old[SERVOS];
+	uint16_t new[SERVOS];
+	struct servo_group_stats before;
+	struct servo_group_stats after;
+	uint32_t writes;
+	int landed = -1;
+
+	setup();
+	CHECK(servo_group_set_all(&dev, 90) == 0, "set_all failed");
+	fake_pwm_run(&pwm_reg, 3);
+
+	for (int round = 0; round < 20; round++) {
+		for (int i = 0; i < SERVOS; i++) {
+			angle_q8[i] = SERVO_ANGLE_Q8((angles[i] + 37 * round) % 181);
+			old[i] = output(i);
+			new[i] = to_compare(&luts[i], angle_q8[i]);
+		}
+
+		servo_group_stats_get(&dev, &before);
+		writes = pwm_reg.reg_writes;
+
+		CHECK(servo_group_set_angles_q8(&dev, angle_q8, SERVOS) == 0, "update failed");
+
+		servo_group_stats_get(&dev, &after);
+		CHECK(after.reg_writes - before.reg_writes == 2, "update took %u register writes",
+		      after.reg_writes - before.reg_writes);
+		CHECK(pwm_reg.reg_writes - writes == after.reg_writes - before.reg_writes,
+		      "stats count %u writes, peripheral saw %u",
+		      after.reg_writes - before.reg_writes, pwm_reg.reg_writes - writes);
+		CHECK(after.starts == before.starts, "running group restarted playback");
+
+		landed = -1;
+		for (int p = 0; p < 4; p++) {
+			fake_pwm_run(&pwm_reg, 1);
+			if (outputs_equal(new)) {
+				landed = landed < 0 ? p : landed;
+			} else {
+				CHECK(landed < 0 && outputs_equal(old),
+				      "round %d period %d: channels from different updates", round, p);
+			}
+		}
+		CHECK(landed >= 0 && landed < 2, "round %d landed after %d periods", round,
+		      landed + 1);
+	}
+
+	CHECK(servo_group_set_angles_q8(&dev, angle_q8, SERVOS - 1) == -EINVAL,
+	      "wrong count accepted");
+	CHECK(pwm_reg.violations == 0, "%u EasyDMA overruns", pwm_reg.violations);
+}
+
+static void test_hold_takes_no_interrupts(void)
+{
+	struct servo_group_stats stats;
+
+	setup();
+	CHECK(servo_group_set_all(&dev, 30) == 0, "set_all failed");
+	CHECK(servo_group_set_all(&dev, 60) == 0, "set_all failed");
+	fake_pwm_run(&pwm_reg, 1000);
+
+	servo_group_stats_get(&dev, &stats);
+	CHECK(pwm_reg.irqs == 0 && stats.segment_irqs == 0, "%u interrupts while holding",
+	      pwm_reg.irqs);
+	CHECK(output(0) == compare_at(60), "not holding the last angle");
+}
+
+#if defined(CONFIG_APP_SERVO_MOTION)
+/* Largest compare change per period allowed by the speed limit, in us. */
+static uint32_t max_step_us(void)
+{
+	uint64_t deg_x1e6 = (uint64_t)CONFIG_APP_MOTION_MAX_SPEED * PERIOD_US;
+	uint32_t us_per_deg = (MAX_PULSE - MIN_PULSE) / NSEC_PER_USEC / 180;
+
+	/* One extra for the LUT rounding and one for the Q16 speed rounding. */
+	return (uint32_t)((deg_x1e6 * (us_per_deg + 1) + 999999) / 1000000) + 2;
+}
+
+/*
+ * Play @p periods periods, checking every one: all servos agree (same
+ * LUT, same target), the speed limit holds and EasyDMA stays in bounds.
+ * Returns the period at which all outputs first reached @p target_deg.
+ */
+static int play(uint32_t periods, int32_t target_deg)
+{
+	uint16_t prev = output(0);
+	int reached = -1;
+
+	for (uint32_t p = 0; p < periods; p++) {
+		fake_pwm_run(&pwm_reg, 1);
+
+		for (int i = 1; i < SERVOS; i++) {
+			CHECK(output(i) == output(0), "period %u: servo %d at 0x%04x, servo 0 at 0x%04x",
+			      p, i, output(i), output(0));
+		}
+
+		CHECK((uint32_t)abs((int)(output(0) & ~PWM_POLARITY_HIGH) -
+				    (int)(prev & ~PWM_POLARITY_HIGH)) <= max_step_us(),
+		      "period %u: jumped from 0x%04x to 0x%04x", p, prev, output(0));
+		prev = output(0);
+
+		if (reached < 0 && output(0) == compare_at(target_deg)) {
+			reached = p;
+		}
+	}
+
+	CHECK(pwm_reg.violations == 0, "%u EasyDMA overruns", pwm_reg.violations);
+
+	return reached;
+}
+
+static void test_move_reaches_target(void)
+{
+	struct servo_group_stats before;
+	struct servo_group_stats after;
+	struct motion_profile profile;
+	uint32_t irqs;
+	int reached;
+
+	setup();
+	CHECK(servo_group_set_all(&dev, 0) == 0, "set_all failed");
+	fake_pwm_run(&pwm_reg, 2);
+	servo_group_stats_get(&dev, &before);
+
+	CHECK(servo_group_move_all(&dev, 180) == 0, "move failed");
+	motion_profile_plan(&profile, MOTION_SHAPE, SERVO_ANGLE_Q8(180), &data.limits);
+
+	reached = play(SETTLE_PERIODS + profile.steps, 180);
+	servo_group_stats_get(&dev, &after);
+
+	printf("%s: %u-step move done after %d periods, %u interrupts\n", __func__,
+	       profile.steps, reached + 1, after.segment_irqs - before.segment_irqs);
+
+	CHECK(reached >= 0, "never reached the target");
+	/* Arming takes up to two periods, the last segment may run short. */
+	CHECK(reached <= (int)profile.steps + 2, "took %d periods for %u steps", reached + 1,
+	      profile.steps);
+	CHECK(after.moves - before.moves == 1, "%u moves", after.moves - before.moves);
+
+	/* One interrupt per segment, plus the arming one. */
+	irqs = after.segment_irqs - before.segment_irqs;
+	CHECK(irqs <= (profile.steps + SEG_PERIODS - 1) / SEG_PERIODS + 2,
+	      "%u interrupts for %u steps", irqs, profile.steps);
+
+	/* Holding again: interrupts masked, output steady. */
+	irqs = pwm_reg.irqs;
+	fake_pwm_run(&pwm_reg, 500);
+	CHECK(pwm_reg.irqs == irqs, "interrupts after the move ended");
+	CHECK(output(0) == compare_at(180), "drifted off the target");
+}
+
+static void test_move_preempted(void)
+{
+	int reached;
+
+	setup();
+	CHECK(servo_group_set_all(&dev, 0) == 0, "set_all failed");
+	fake_pwm_run(&pwm_reg, 2);
+
+	CHECK(servo_group_move_all(&dev, 180) == 0, "move failed");
+	(void)play(25, 180);
+	CHECK(servo_group_move_all(&dev, 20) == 0, "preempting move failed");
+
+	reached = play(SETTLE_PERIODS, 20);
+	CHECK(reached >= 0, "never reached the preempting target");
+	CHECK(output(0) == compare_at(20), "did not end on the preempting target");
+}
+
+/* Each group plans with the limits of its own period, whatever inits last. */
+static void test_limits_per_group(void)
+{
+	static NRF_PWM_Type other_reg;
+	static struct servo_group_data other_data;
+	static const struct servo_group_config other_config = {
+		.pwm = {.p_reg = &other_reg},
+		.irq_connect = irq_connect,
+		.pcfg = &pcfg,
+		.top = PERIOD_US / 2,
+		.count = SERVOS,
+		.channels = channels,
+		.luts = luts,
+	};
+	static const struct device other = {
+		.name = "servo_group_fast",
+		.config = &other_config,
+		.data = &other_data,
+	};
+	struct motion_limits expect;
+	struct motion_limits expect_other;
+
+	setup();
+	CHECK(servo_group_init(&other) == 0, "second init failed");
+
+	motion_limits_from_rate(&expect, CONFIG_APP_MOTION_MAX_SPEED, CONFIG_APP_MOTION_MAX_ACCEL,
+				PERIOD_US);
+	motion_limits_from_rate(&expect_other, CONFIG_APP_MOTION_MAX_SPEED,
+				CONFIG_APP_MOTION_MAX_ACCEL, PERIOD_US / 2);
+
+	CHECK(data.limits.vel_q16 == expect.vel_q16 && data.limits.acc_q16 == expect.acc_q16,
+	      "20 ms group has %u/%u per step, expected %u/%u", data.limits.vel_q16,
+	      data.limits.acc_q16, expect.vel_q16, expect.acc_q16);
+	CHECK(other_data.limits.vel_q16 == expect_other.vel_q16 &&
+		      other_data.limits.acc_q16 == expect_other.acc_q16,
+	      "10 ms group has %u/%u per step, expected %u/%u", other_data.limits.vel_q16,
+	      other_data.limits.acc_q16, expect_other.vel_q16, expect_other.acc_q16);
+}
+
+/*
+ * Cancelling a move from thread context repoints both sequences from a
+ * segment back to a one-period hold buffer while the PWM keeps playing.
+ */
+static void test_set_cancels_move(void)
+{
+	struct servo_group_stats before;
+	struct servo_group_stats after;
+	uint32_t writes;
+
+	for (uint32_t offset = 0; offset < 2 * SEG_PERIODS + 3; offset++) {
+		setup();
+		CHECK(servo_group_set_all(&dev, 0) == 0, "set_all failed");
+		fake_pwm_run(&pwm_reg, 2);
+		CHECK(servo_group_move_all(&dev, 180) == 0, "move failed");
+		fake_pwm_run(&pwm_reg, offset);
+
+		servo_group_stats_get(&dev, &before);
+		writes = pwm_reg.reg_writes;
+		CHECK(servo_group_set_all(&dev, 45) == 0, "set_all failed");
+		servo_group_stats_get(&dev, &after);
+
+		CHECK(pwm_reg.reg_writes - writes == after.reg_writes - before.reg_writes,
+		      "stats count %u writes, peripheral saw %u",
+		      after.reg_writes - before.reg_writes, pwm_reg.reg_writes - writes);
+
+		/* Whatever segment is latched plays out, then the hold. */
+		fake_pwm_run(&pwm_reg, 2 * SEG_PERIODS + 1);
+		CHECK(output(0) == compare_at(45), "offset %u: not holding after cancel", offset);
+		CHECK(pwm_reg.violations == 0, "offset %u: %u EasyDMA overruns", offset,
+		      pwm_reg.violations);
+	}
+}
+#endif /* CONFIG_APP_SERVO_MOTION */
+
+#if defined(CONFIG_APP_SERVO_GROUP_PM)
+static bool parked(void)
+{
+	return nrfx_pwm_is_stopped(&config.pwm) && pcfg.state == PINCTRL_STATE_SLEEP;
+}
+
+/*
+ * After the hold timeout the PWM stops and the pins go to sleep. The next
+ * update restarts playback with all channels on the new angle in the very
+ * first period.
+ */
+static void test_park_and_resume(void)
+{
+	struct servo_group_stats stats;
+
+	setup();
+	CHECK(servo_group_set_all(&dev, 90) == 0, "set_all failed");
+	CHECK(pcfg.state == PINCTRL_STATE_DEFAULT, "pins not resumed");
+	CHECK(data.park.timeout.ms == CONFIG_APP_SERVO_HOLD_TIMEOUT_MS, "park in %lld ms",
+	      (long long)data.park.timeout.ms);
+	fake_pwm_run(&pwm_reg, 3);
+
+	CHECK(host_work_expire(&data.park), "hold timeout not scheduled");
+	servo_group_stats_get(&dev, &stats);
+	CHECK(parked(), "not parked after the hold timeout");
+	CHECK(stats.parks == 1, "%u parks", stats.parks);
+	CHECK(pm.usage == 0, "%d runtime PM references left", pm.usage);
+
+	fake_pwm_run(&pwm_reg, 1);
+	CHECK(output(0) == 0, "parked group still drives 0x%04x", output(0));
+
+	CHECK(servo_group_set_all(&dev, 45) == 0, "resuming set_all failed");
+	servo_group_stats_get(&dev, &stats);
+	CHECK(!nrfx_pwm_is_stopped(&config.pwm) && pcfg.state == PINCTRL_STATE_DEFAULT,
+	      "update did not resume the group");
+	CHECK(stats.starts == 2, "%u playback starts", stats.starts);
+
+	fake_pwm_run(&pwm_reg, 1);
+	for (int i = 0; i < SERVOS; i++) {
+		CHECK(output(i) == compare_at(45), "servo %d at 0x%04x after resume", i, output(i));
+	}
+	CHECK(pwm_reg.violations == 0, "%u EasyDMA overruns", pwm_reg.violations);
+}
+
+/*
+ * An update that takes the lock while the park item is already running
+ * reschedules it; that run must then leave the group alone.
+ */
+static void test_update_races_park(void)
+{
+	setup();
+	CHECK(servo_group_set_all(&dev, 90) == 0, "set_all failed");
+	fake_pwm_run(&pwm_reg, 3);
+
+	/* The update lands between the timeout firing and the handler. */
+	CHECK(servo_group_set_all(&dev, 100) == 0, "set_all failed");
+	servo_group_park(&data.park.work);
+
+	CHECK(!parked(), "parked right after an update");
+	CHECK(k_work_delayable_is_pending(&data.park), "park no longer scheduled");
+	CHECK(host_work_expire(&data.park) && parked(), "rescheduled park did not park");
+}
+
+#if defined(CONFIG_APP_SERVO_MOTION)
+/* The hold timeout counts from the end of a move, however long it runs. */
+static void test_no_park_during_move(void)
+{
+	setup();
+	CHECK(servo_group_set_all(&dev, 0) == 0, "set_all failed");
+	fake_pwm_run(&pwm_reg, 2);
+	CHECK(servo_group_move_all(&dev, 180) == 0, "move failed");
+	fake_pwm_run(&pwm_reg, 5);
+
+	CHECK(host_work_expire(&data.park), "hold timeout not scheduled");
+	CHECK(!parked(), "parked during a move");
+	CHECK(k_work_delayable_is_pending(&data.park), "park not deferred past the move");
+
+	CHECK(play(SETTLE_PERIODS, 180) >= 0, "move did not finish");
+	CHECK(host_work_expire(&data.park) && parked(), "not parked after the move");
+
+	/* A move from parked resumes on the last position and follows the profile. */
+	struct servo_group_stats before;
+	struct servo_group_stats after;
+	struct motion_profile profile;
+	int reached;
+
+	servo_group_stats_get(&dev, &before);
+	CHECK(servo_group_move_all(&dev, 90) == 0, "move from parked failed");
+	CHECK(!parked(), "move did not resume the group");
+	fake_pwm_run(&pwm_reg, 1);
+	CHECK(output(0) == compare_at(180), "resumed at 0x%04x, not on the last position",
+	      output(0));
+
+	motion_profile_plan(&profile, MOTION_SHAPE, SERVO_ANGLE_Q8(90), &data.limits);
+	reached = play(SETTLE_PERIODS + profile.steps, 90);
+	servo_group_stats_get(&dev, &after);
+
+	CHECK(reached >= (int)profile.steps - 2, "reached the target after %d periods, profile "
+	      "has %u steps", reached + 1, profile.steps);
+	CHECK(after.moves - before.moves == 1, "%u moves after resume", after.moves - before.moves);
+	CHECK(after.starts - before.starts == 1, "%u playback starts on resume",
+	      after.starts - before.starts);
+}
+#endif
+#endif /* CONFIG_APP_SERVO_GROUP_PM */
+
+int main(void)
+{
+	test_first_update_starts_playback();
+	test_update_lands_in_one_period();
+	test_hold_takes_no_interrupts();
+#if defined(CONFIG_APP_SERVO_MOTION)
+	test_move_reaches_target();
+	test_move_preempted();
+	test_set_cancels_move();
+	test_limits_per_group();
+#endif
+#if defined(CONFIG_APP_SERVO_GROUP_PM)
+	test_park_and_resume();
+	test_update_races_park();
+#if defined(CONFIG_APP_SERVO_MOTION)
+	test_no_park_during_move();
+#endif
+#endif
+
+	HOST_TEST_EXIT();
+}
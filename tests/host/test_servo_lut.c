@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Accuracy of servo_lut_pulse() against the exact piecewise-linear mapping,
+ * over every Q8 angle of a few representative servos. Tables are filled the
+ * way servo_dt.h fills them at build time.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "host_test.h"
+#include "servo_lut.h"
+
+#define USEC(us) ((uint32_t)(us) * 1000U)
+
+struct servo_case {
+	const char *name;
+	int32_t min_deg;
+	int32_t max_deg;
+	/* Calibration points, min-angle first and max-angle last. */
+	int32_t angles[8];
+	uint32_t pulses[8];
+	int points;
+};
+
+static const struct servo_case cases[] = {
+	{"linear 0-180", 0, 180, {0, 180}, {USEC(1000), USEC(2000)}, 2},
+	{"linear 0-270", 0, 270, {0, 270}, {USEC(500), USEC(2500)}, 2},
+	{"linear 10-20", 10, 20, {10, 20}, {USEC(1400), USEC(1600)}, 2},
+	{"reversed 0-180", 0, 180, {0, 180}, {USEC(2000), USEC(1000)}, 2},
+	{"calibrated on entries", 0, 180, {0, 90, 180}, {USEC(1000), USEC(1480), USEC(2000)}, 3},
+	{"calibrated off entries", 0, 180, {0, 30, 100, 180},
+	 {USEC(1000), USEC(1200), USEC(1500), USEC(2000)}, 4},
+};
+
+/* Exact pulse for angle @p x (Q8) through the calibration points. */
+static double reference(const struct servo_case *c, int32_t x)
+{
+	double deg = x / 256.0;
+
+	if (deg <= c->angles[0]) {
+		return c->pulses[0];
+	}
+
+	for (int i = 1; i < c->points; i++) {
+		if (deg <= c->angles[i]) {
+			double t = (deg - c->angles[i - 1]) / (c->angles[i] - c->angles[i - 1]);
+
+			return c->pulses[i - 1] + t * ((double)c->pulses[i] - c->pulses[i - 1]);
+		}
+	}
+
+	return c->pulses[c->points - 1];
+}
+
+/* Same arithmetic as SERVO_PULSE_CALIBRATED()/SERVO_PULSE_LINEAR(). */
+static uint32_t entry_pulse(const struct servo_case *c, int32_t x)
+{
+	for (int i = 1; i < c->points; i++) {
+		if (x <= SERVO_ANGLE_Q8(c->angles[i])) {
+			return SERVO_LUT_LERP(SERVO_ANGLE_Q8(c->angles[i - 1]), c->pulses[i - 1],
+					      SERVO_ANGLE_Q8(c->angles[i]), c->pulses[i], x);
+		}
+	}
+
+	return c->pulses[c->points - 1];
+}
+
+/* Same arithmetic as SERVO_LUT_DT_INIT(). */
+static void build(const struct servo_case *c, struct servo_lut *lut)
+{
+	lut->min_q8 = SERVO_ANGLE_Q8(c->min_deg);
+	lut->max_q8 = SERVO_ANGLE_Q8(c->max_deg);
+	lut->scale = SERVO_LUT_SCALE(c->max_deg - c->min_deg);
+
+	for (int k = 0; k < SERVO_LUT_ENTRIES; k++) {
+		int32_t x = lut->min_q8 +
+			    (SERVO_ANGLE_Q8(c->max_deg - c->min_deg) * k) / SERVO_LUT_SEGMENTS;
+
+		lut->pulse[k] = entry_pulse(c, x);
+	}
+}
+
+/*
+ * Between table entries the lookup interpolates with a Q8 fraction, so a
+ * straight mapping is off by up to one 1/256 step of the steepest segment,
+ * plus a little for the rounded-up scale. A calibration point that falls
+ * between two table entries is cut off by the chord between them, which
+ * costs up to a quarter of the slope change times the entry spacing.
+ */
+static double error_limit(const struct servo_case *c, const struct servo_lut *lut)
+{
+	double spacing = (double)(c->max_deg - c->min_deg) / SERVO_LUT_SEGMENTS;
+	double step = 0.0;
+	double kink = 0.0;
+
+	for (int k = 0; k < SERVO_LUT_SEGMENTS; k++) {
+		step = fmax(step, fabs((double)lut->pulse[k + 1] - lut->pulse[k]) / 256.0);
+	}
+
+	for (int i = 1; i < c->points - 1; i++) {
+		double before = ((double)c->pulses[i] - c->pulses[i - 1]) /
+				(c->angles[i] - c->angles[i - 1]);
+		double after = ((double)c->pulses[i + 1] - c->pulses[i]) /
+			       (c->angles[i + 1] - c->angles[i]);
+
+		if ((c->angles[i] - c->min_deg) * SERVO_LUT_SEGMENTS %
+		    (c->max_deg - c->min_deg) != 0) {
+			kink = fmax(kink, fabs(after - before) * spacing / 4.0);
+		}
+	}
+
+	return step * 1.125 + 2.0 + kink;
+}
+
+static void check_case(const struct servo_case *c)
+{
+	struct servo_lut lut;
+	bool rising = c->pulses[c->points - 1] > c->pulses[0];
+	uint32_t prev = 0;
+	double worst = 0.0;
+	int32_t worst_at = 0;
+	double limit;
+
+	build(c, &lut);
+	limit = error_limit(c, &lut);
+
+	CHECK(servo_lut_pulse(&lut, lut.min_q8) == c->pulses[0], "%s: wrong pulse at min-angle",
+	      c->name);
+	CHECK(servo_lut_pulse(&lut, lut.max_q8) == c->pulses[c->points - 1],
+	      "%s: wrong pulse at max-angle", c->name);
+	CHECK(servo_lut_pulse(&lut, lut.min_q8 - 1000) == c->pulses[0],
+	      "%s: not clamped below min-angle", c->name);
+	CHECK(servo_lut_pulse(&lut, lut.max_q8 + 1000) == c->pulses[c->points - 1],
+	      "%s: not clamped above max-angle", c->name);
+
+	for (int32_t x = lut.min_q8; x <= lut.max_q8; x++) {
+		uint32_t pulse = servo_lut_pulse(&lut, x);
+		double err = fabs(pulse - reference(c, x));
+
+		if (err > worst) {
+			worst = err;
+			worst_at = x;
+		}
+
+		if (x > lut.min_q8) {
+			CHECK(rising ? pulse >= prev : pulse <= prev,
+			      "%s: not monotonic at %d/256 degrees (%u after %u)", c->name, x, pulse,
+			      prev);
+		}
+		prev = pulse;
+	}
+
+	printf("%-24s worst error %7.1f ns at %7.2f degrees (limit %7.1f ns)\n", c->name, worst,
+	       worst_at / 256.0, limit);
+	CHECK(worst <= limit, "%s: error %.1f ns at %d/256 degrees exceeds %.1f ns", c->name,
+	      worst, worst_at, limit);
+}
+
+int main(void)
+{
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		check_case(&cases[i]);
+	}
+
+	HOST_TEST_EXIT();
+}
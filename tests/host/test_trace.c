@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Histogram and summary bookkeeping of src/trace.c on a scripted cycle
+ * counter, then what a tracepoint costs: exactly one counter read. The
+ * per-call host time is printed for reference only.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "host_test.h"
+
+#include "trace.c"
+
+#define CALLS 1000000U
+
+static uint32_t now_cyc;
+static uint32_t clock_reads;
+
+uint32_t k_cycle_get_32(void)
+{
+	clock_reads++;
+
+	return now_cyc;
+}
+
+/* Record a sample of exactly @p delta cycles, starting from @p edge_cyc. */
+static void record(enum trace_stage stage, uint32_t edge_cyc, uint32_t delta)
+{
+	now_cyc = edge_cyc + delta;
+	trace_record(stage, edge_cyc);
+}
+
+static uint32_t bucket_total(enum trace_stage stage)
+{
+	uint32_t total = 0;
+
+	for (uint8_t b = 0; b < BUCKETS; b++) {
+		total += trace_bucket_get(stage, b);
+	}
+
+	return total;
+}
+
+static void test_empty(void)
+{
+	struct trace_summary summary;
+
+	trace_reset();
+
+	for (int s = 0; s < TRACE_STAGE_COUNT; s++) {
+		CHECK(trace_summary_get(s, &summary) == -ENODATA, "stage %d: summary while empty",
+		      s);
+		CHECK(bucket_total(s) == 0, "stage %d: buckets while empty", s);
+	}
+
+	CHECK(trace_bucket_get(TRACE_STAGE_HANDLER, BUCKETS) == 0, "bucket past the end");
+}
+
+static void test_buckets(void)
+{
+	static const struct {
+		uint32_t delta;
+		uint8_t bucket;
+	} cases[] = {
+		{0, 0},          {1, 0},           {2, 1},          {3, 1},
+		{4, 2},          {7, 2},           {8, 3},          {1000, 9},
+		{1023, 9},       {1024, 10},       {BIT(31), 31},   {UINT32_MAX, 31},
+	};
+	uint32_t expected[BUCKETS] = {0};
+
+	trace_reset();
+
+	for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+		record(TRACE_STAGE_DEQUEUE, 12345, cases[i].delta);
+		expected[cases[i].bucket]++;
+	}
+
+	/* The counter wraps between the edge and the tracepoint. */
+	record(TRACE_STAGE_DEQUEUE, UINT32_MAX - 15, 32);
+	expected[5]++;
+
+	for (uint8_t b = 0; b < BUCKETS; b++) {
+		CHECK(trace_bucket_get(TRACE_STAGE_DEQUEUE, b) == expected[b],
+		      "bucket %u holds %u, expected %u", b, trace_bucket_get(TRACE_STAGE_DEQUEUE, b),
+		      expected[b]);
+	}
+
+	CHECK(bucket_total(TRACE_STAGE_HANDLER) == 0, "samples leaked into another stage");
+	CHECK(bucket_total(TRACE_STAGE_PWM_DONE) == 0, "samples leaked into another stage");
+}
+
+static void test_summary(void)
+{
+	struct trace_summary summary;
+	const uint32_t n = 100;
+
+	trace_reset();
+
+	/* 1..100 in a scrambled order; 37 is coprime with 100. */
+	for (uint32_t i = 0; i < n; i++) {
+		record(TRACE_STAGE_HANDLER, 500, 1 + (i * 37) % n);
+	}
+
+	CHECK(trace_summary_get(TRACE_STAGE_HANDLER, &summary) == 0, "no summary");
+	CHECK(summary.count == n, "count %u", summary.count);
+	CHECK(summary.min_cyc == 1, "min %u", summary.min_cyc);
+	CHECK(summary.avg_cyc == 50, "avg %u", summary.avg_cyc);
+	CHECK(summary.p99_cyc == 100, "p99 %u", summary.p99_cyc);
+	CHECK(summary.max_cyc == 100, "max %u", summary.max_cyc);
+	CHECK(trace_summary_get(TRACE_STAGE_PWM_DONE, &summary) == -ENODATA,
+	      "samples leaked into another stage");
+}
+
+/*
+ * Past SAMPLES the ring keeps only the newest samples for the summary,
+ * while the count and the histogram keep every sample since the reset.
+ */
+static void test_ring_wrap(void)
+{
+	struct trace_summary summary;
+	const uint32_t total = 3 * SAMPLES + 5;
+
+	trace_reset();
+
+	for (uint32_t i = 0; i < total; i++) {
+		record(TRACE_STAGE_PWM_DONE, 0, i);
+	}
+
+	CHECK(trace_summary_get(TRACE_STAGE_PWM_DONE, &summary) == 0, "no summary");
+	CHECK(summary.count == total, "count %u, recorded %u", summary.count, total);
+	CHECK(summary.min_cyc == total - SAMPLES, "min %u, oldest held %u", summary.min_cyc,
+	      total - SAMPLES);
+	CHECK(summary.max_cyc == total - 1, "max %u", summary.max_cyc);
+	CHECK(bucket_total(TRACE_STAGE_PWM_DONE) == total, "histogram holds %u of %u",
+	      bucket_total(TRACE_STAGE_PWM_DONE), total);
+
+	trace_reset();
+	CHECK(trace_summary_get(TRACE_STAGE_PWM_DONE, &summary) == -ENODATA,
+	      "samples survived the reset");
+	CHECK(bucket_total(TRACE_STAGE_PWM_DONE) == 0, "histogram survived the reset");
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000U + ts.tv_nsec;
+}
+
+static void test_overhead(void)
+{
+	uint64_t start;
+	double record_ns;
+
+	trace_reset();
+	clock_reads = 0;
+	start = now_ns();
+	for (uint32_t i = 0; i < CALLS; i++) {
+		/* Spread the deltas over every bucket. */
+		now_cyc = i * 2654435761U;
+		trace_record(TRACE_STAGE_DEQUEUE, 0);
+	}
+	record_ns = (double)(now_ns() - start) / CALLS;
+
+	printf("trace_record %.1f ns per call (host)\n", record_ns);
+
+	CHECK(clock_reads == CALLS, "%u counter reads for %u records", clock_reads, CALLS);
+	CHECK(bucket_total(TRACE_STAGE_DEQUEUE) == CALLS, "histogram holds %u of %u",
+	      bucket_total(TRACE_STAGE_DEQUEUE), CALLS);
+}
+
+int main(void)
+{
+	test_empty();
+	test_buckets();
+	test_summary();
+	test_ring_wrap();
+	test_overhead();
+
+	HOST_TEST_EXIT();
+}
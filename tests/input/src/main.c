@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/sys/util.h>
+
+#include "input.h"
+
+#define BUTTONS_NODE DT_PATH(buttons)
+
+#define BUTTON_SPEC(node_id) GPIO_DT_SPEC_GET(node_id, gpios),
+
+#define WINDOW_MS CONFIG_APP_INPUT_DEBOUNCE_MS
+/* Enough for a window opened by a late report to close as well. */
+#define QUIET_MS  (3 * WINDOW_MS)
+
+static const struct gpio_dt_spec buttons[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY(BUTTONS_NODE, BUTTON_SPEC)
+};
+
+struct seen_event {
+	struct input_event evt;
+	uint32_t call_cyc;
+};
+
+static struct seen_event seen[64];
+static size_t seen_count;
+
+static void handler(const struct input_event *evt)
+{
+	if (seen_count < ARRAY_SIZE(seen)) {
+		seen[seen_count].evt = *evt;
+		seen[seen_count].call_cyc = k_cycle_get_32();
+	}
+	seen_count++;
+}
+
+/* Returns the cycle count at which the level changed. */
+static uint32_t set_button(uint8_t button, bool pressed)
+{
+	const struct gpio_dt_spec *btn = &buttons[button];
+	bool active_low = (btn->dt_flags & GPIO_ACTIVE_LOW) != 0;
+	uint32_t now = k_cycle_get_32();
+
+	/* The emulator runs the input ISR synchronously from here. */
+	zassert_ok(gpio_emul_input_set(btn->port, btn->pin, pressed != active_low));
+
+	return now;
+}
+
+static const struct seen_event *last_event(uint8_t button, bool pressed)
+{
+	for (size_t i = MIN(seen_count, ARRAY_SIZE(seen)); i > 0; i--) {
+		if (seen[i - 1].evt.button == button && seen[i - 1].evt.pressed == pressed) {
+			return &seen[i - 1];
+		}
+	}
+
+	return NULL;
+}
+
+static void *input_setup(void)
+{
+	zassert_ok(input_init(handler));
+
+	return NULL;
+}
+
+static void input_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (uint8_t i = 0; i < ARRAY_SIZE(buttons); i++) {
+		(void)set_button(i, false);
+	}
+
+	k_msleep(QUIET_MS);
+	seen_count = 0;
+}
+
+ZTEST(input, test_press_on_stable_button_is_immediate)
+{
+	uint32_t pressed_cyc = set_button(INPUT_BTN1, true);
+	const struct seen_event *ev = last_event(INPUT_BTN1, true);
+
+	zassert_not_null(ev, "press not reported from the edge interrupt");
+	zassert_equal(ev->evt.edge_cyc, pressed_cyc);
+	zassert_equal(ev->call_cyc - pressed_cyc, 0, "press delayed by %u cycles",
+		      ev->call_cyc - pressed_cyc);
+}
+
+ZTEST(input, test_bounce_is_filtered)
+{
+	(void)set_button(INPUT_BTN2, true);
+	for (int i = 0; i < 4; i++) {
+		k_msleep(1);
+		(void)set_button(INPUT_BTN2, false);
+		k_msleep(1);
+		(void)set_button(INPUT_BTN2, true);
+	}
+
+	k_msleep(QUIET_MS);
+
+	zassert_equal(seen_count, 1, "%zu events for one bouncy press", seen_count);
+	zassert_true(seen[0].evt.pressed);
+}
+
+/*
+ * The slowest press is one that lands just after a late release report:
+ * that report opened a fresh window, so the press waits for it to close.
+ * Sweep the press across that window and check every press is reported
+ * within one window plus tick rounding.
+ */
+ZTEST(input, test_worst_case_press_latency)
+{
+	uint32_t limit_us = WINDOW_MS * USEC_PER_MSEC + 2 * k_ticks_to_us_ceil32(1);
+	uint32_t worst_us = 0;
+
+	for (int offset_ms = 0; offset_ms <= WINDOW_MS + 2; offset_ms++) {
+		const struct seen_event *ev;
+		uint32_t pressed_cyc;
+		uint32_t latency_us;
+
+		seen_count = 0;
+
+		/* Short press: the release falls inside the press window. */
+		(void)set_button(INPUT_BTN3, true);
+		k_msleep(2);
+		(void)set_button(INPUT_BTN3, false);
+		k_msleep(WINDOW_MS);
+		zassert_not_null(last_event(INPUT_BTN3, false), "late release not reported");
+
+		k_msleep(offset_ms);
+		pressed_cyc = set_button(INPUT_BTN3, true);
+		k_msleep(QUIET_MS);
+
+		ev = last_event(INPUT_BTN3, true);
+		zassert_true(ev != NULL && (int32_t)(ev->call_cyc - pressed_cyc) >= 0,
+			     "press %d ms after the late release was lost", offset_ms);
+
+		latency_us = k_cyc_to_us_ceil32(ev->call_cyc - pressed_cyc);
+		worst_us = MAX(worst_us, latency_us);
+
+		(void)set_button(INPUT_BTN3, false);
+		k_msleep(QUIET_MS);
+	}
+
+	TC_PRINT("worst-case press latency %u us, limit %u us\n", worst_us, limit_us);
+	zassert_true(worst_us <= limit_us, "worst-case press latency %u us > %u us", worst_us,
+		     limit_us);
+}
+
+ZTEST(input, test_idle_buttons_do_not_wake_up)
+{
+	struct input_stats before;
+	struct input_stats after;
+
+	/* Leave a settle window behind, then go quiet. */
+	(void)set_button(INPUT_BTN4, true);
+	k_msleep(QUIET_MS);
+
+	input_stats_get(&before);
+	k_msleep(1000);
+	input_stats_get(&after);
+
+	zassert_equal(after.edges, before.edges, "edge interrupts while idle");
+	zassert_equal(after.settles, before.settles, "settle timer ran while idle");
+	zassert_equal(after.events, before.events, "events while idle");
+
+	/* Every report opens exactly one window, which closes exactly once. */
+	zassert_equal(after.settles, after.events, "%u windows closed for %u reports",
+		      after.settles, after.events);
+}
+
+ZTEST_SUITE(input, NULL, input_setup, input_before, NULL, NULL);
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/sys/util.h>
+
+#include "motor.h"
+#include "pwm_emul.h"
+#include "servo.h"
+
+#define SERVO_NODE   DT_NODELABEL(servo)
+#define PERIOD_MS    (DT_PWMS_PERIOD(SERVO_NODE) / NSEC_PER_MSEC)
+#define RUN_MS       2000
+/* Posts per producer tick, far more than one PWM period can apply. */
+#define POSTS_PER_MS 8
+
+static const struct device *const servo = DEVICE_DT_GET(SERVO_NODE);
+static const struct device *const pwm = DEVICE_DT_GET(DT_PWMS_CTLR(SERVO_NODE));
+
+/* Producer state, only touched from the timer ISR while it runs. */
+static uint32_t attempts;
+static uint32_t accepted;
+static uint32_t rejected;
+static int32_t last_deg;
+static int32_t next_deg;
+
+static void producer(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	for (int i = 0; i < POSTS_PER_MS; i++) {
+		int err = motor_post(MOTOR_SERVO, next_deg, k_cycle_get_32());
+
+		attempts++;
+		if (err == 0) {
+			accepted++;
+			last_deg = next_deg;
+		} else if (err == -ENOBUFS) {
+			rejected++;
+		}
+		next_deg = (next_deg + 7) % 181;
+	}
+}
+
+static K_TIMER_DEFINE(producer_timer, producer, NULL);
+
+static void *motor_setup(void)
+{
+	zassert_ok(motor_init(90));
+
+	return NULL;
+}
+
+ZTEST(motor, test_invalid_targets)
+{
+	zassert_equal(motor_post(MOTOR_TARGET_COUNT, 0, 0), -ENOTSUP);
+	zassert_equal(motor_post(MOTOR_GROUP, 0, 0), -ENOTSUP);
+}
+
+/*
+ * An ISR floods the queue for a while. Every command must be accounted for
+ * exactly once, the ring must never hold more than it has room for, the
+ * thread must apply at most one command per PWM period and the servo must
+ * end on the newest angle that was accepted.
+ */
+ZTEST(motor, test_isr_flood)
+{
+	struct motor_stats before;
+	struct motor_stats after;
+	uint32_t posted;
+	uint32_t applied;
+	uint32_t periods;
+	uint32_t period_ns;
+	uint32_t pulse_ns;
+
+	motor_stats_get(&before);
+
+	k_timer_start(&producer_timer, K_MSEC(1), K_MSEC(1));
+	k_msleep(RUN_MS);
+	k_timer_stop(&producer_timer);
+
+	/* Let the thread drain the tail end. */
+	k_msleep(3 * PERIOD_MS);
+	motor_stats_get(&after);
+
+	posted = after.posted - before.posted;
+	applied = after.applied - before.applied;
+	periods = RUN_MS / PERIOD_MS;
+
+	TC_PRINT("%u posts: %u queued, %u dropped, %u coalesced, %u applied, depth max %u\n",
+		 attempts, posted, after.dropped - before.dropped,
+		 after.coalesced - before.coalesced, applied, after.depth_max);
+
+	zassert_true(attempts >= (RUN_MS - PERIOD_MS) * POSTS_PER_MS, "producer starved");
+	zassert_equal(posted, accepted);
+	zassert_equal(after.dropped - before.dropped, rejected);
+	zassert_equal(posted + rejected, attempts, "commands lost between post and counters");
+	zassert_true(rejected > 0, "queue never filled, the test is not stressing it");
+
+	zassert_equal(applied + after.coalesced - before.coalesced, posted,
+		      "every queued command must be applied or coalesced exactly once");
+	zassert_true(after.depth_max <= CONFIG_APP_MOTOR_QUEUE_SIZE, "depth %u exceeds the ring",
+		     after.depth_max);
+	zassert_true(applied <= periods + 2, "%u applies in %u PWM periods", applied, periods);
+	zassert_true(applied >= periods / 2, "only %u applies in %u PWM periods", applied,
+		     periods);
+
+	zassert_ok(pwm_emul_channel_get(pwm, DT_PWMS_CHANNEL(SERVO_NODE), &period_ns, &pulse_ns));
+	zassert_equal(pulse_ns, servo_angle_to_pulse(servo, SERVO_ANGLE_Q8(last_deg)),
+		      "servo did not end on the last accepted angle %d", last_deg);
+}
+
+ZTEST_SUITE(motor, NULL, motor_setup, NULL, NULL, NULL);